@@ -143,15 +143,22 @@ static u64 u64_to_u64(u64 v) {return (u64)v;}
 static float double_to_float(double v) {return (float)v;}
 static double float_to_double(float v) {return (double)v;}
 
-static u64 float_to_s32(float v) {return s32_to_u64((s32)v);}
-static u64 float_to_u32(float v) {return u32_to_u64((u32)v);}
-static u64 float_to_s64(float v) {return s64_to_u64((s64)v);}
-static u64 float_to_u64(float v) {return u64_to_u64((u64)v);}
-
-static u64 double_to_s32(double v) {return s32_to_u64((s32)v);}
-static u64 double_to_u32(double v) {return u32_to_u64((u32)v);}
-static u64 double_to_s64(double v) {return s64_to_u64((s64)v);}
-static u64 double_to_u64(double v) {return u64_to_u64((u64)v);}
+/* Conversions to integers saturate and make NaNs zero as the
+   instructions do (casts in C are undefined out of the range). */
+
+/*NEON*/
+static u64 float_to_s32(float v) {return s32_to_u64(vcvts_s32_f32(v));}
+static u64 float_to_u32(float v) {return u32_to_u64(vcvts_u32_f32(v));}
+static u64 float_to_s64(float v) {return s64_to_u64(vcvtd_s64_f64(v));}
+static u64 float_to_u64(float v) {return u64_to_u64(vcvtd_u64_f64(v));}
+
+/*NEON*/
+static u64 double_to_s32(double v) {
+    return s32_to_u64(vqmovnd_s64(vcvtd_s64_f64(v)));}
+static u64 double_to_u32(double v) {
+    return u32_to_u64(vqmovnd_u64(vcvtd_u64_f64(v)));}
+static u64 double_to_s64(double v) {return s64_to_u64(vcvtd_s64_f64(v));}
+static u64 double_to_u64(double v) {return u64_to_u64(vcvtd_u64_f64(v));}
 
 static float s32_to_float(s32 v) {return (float)v;}
 static float u32_to_float(u32 v) {return (float)v;}
@@ -163,6 +170,35 @@ static double u32_to_double(u32 v) {return (double)v;}
 static double s64_to_double(s64 v) {return (double)v;}
 static double u64_to_double(u64 v) {return (double)v;}
 
+/* Conversions of half-precision.  They are by NEON, since C has no
+   half-precision type.  Double-precision is narrowed by round-to-odd
+   to single-precision first, so that it is rounded once. */
+
+static float
+hf_to_float(u16 v)
+{
+    /*NEON*/
+    float16x4_t v0 = vreinterpret_f16_u16(vdup_n_u16(v));
+    return vgetq_lane_f32(vcvt_f32_f16(v0), 0);
+}
+
+static u16
+float_to_hf(float v)
+{
+    /*NEON*/
+    float16x4_t v0 = vcvt_f16_f32(vdupq_n_f32(v));
+    return vget_lane_u16(vreinterpret_u16_f16(v0), 0);
+}
+
+static u16
+double_to_hf(double v)
+{
+    /*NEON*/
+    float32x2_t v0 = vcvtx_f32_f64(vdupq_n_f64(v));
+    float16x4_t v1 = vcvt_f16_f32(vcombine_f32(v0, v0));
+    return vget_lane_u16(vreinterpret_u16_f16(v1), 0);
+}
+
 static bool
 sve_insn_p(u32 opc)
 {
@@ -473,6 +509,88 @@ ElemP_set(svecxt_t *zx, preg *p, int e, int esize, bool value)
     }
 }
 
+/* Expands the predicates of the elements in a 128-bit segment
+   starting at element E into NEON lane masks (all ones for an active
+   element).  The predicate of an element is the lowest byte of the
+   lane, and the other bytes are ignored as in ElemP_get(). */
+
+static uint8x16_t
+ElemP_lanes8(svecxt_t *zx, preg *p, int e)
+{
+    assert(e >= 0 && (e + 16) <= zx->PL);
+    /*NEON*/
+    uint8x16_t v = vld1q_u8((u8 *)&p->k[e]);
+    return vtstq_u8(v, vdupq_n_u8(0xffU));
+}
+
+static uint16x8_t
+ElemP_lanes16(svecxt_t *zx, preg *p, int e)
+{
+    assert(e >= 0 && ((e + 8) * 2) <= zx->PL);
+    /*NEON*/
+    uint16x8_t v = vreinterpretq_u16_u8(vld1q_u8((u8 *)&p->k[e * 2]));
+    return vtstq_u16(v, vdupq_n_u16(0xffU));
+}
+
+static uint32x4_t
+ElemP_lanes32(svecxt_t *zx, preg *p, int e)
+{
+    assert(e >= 0 && ((e + 4) * 4) <= zx->PL);
+    /*NEON*/
+    uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8((u8 *)&p->k[e * 4]));
+    return vtstq_u32(v, vdupq_n_u32(0xffU));
+}
+
+static uint64x2_t
+ElemP_lanes64(svecxt_t *zx, preg *p, int e)
+{
+    assert(e >= 0 && ((e + 2) * 8) <= zx->PL);
+    /*NEON*/
+    uint64x2_t v = vreinterpretq_u64_u8(vld1q_u8((u8 *)&p->k[e * 8]));
+    return vtstq_u64(v, vdupq_n_u64(0xffULL));
+}
+
+static uint8x16_t
+ElemP_lanes(svecxt_t *zx, preg *p, int e, int esize)
+{
+    switch (esize) {
+    case 8:
+	return ElemP_lanes8(zx, p, e);
+    case 16:
+	return vreinterpretq_u8_u16(ElemP_lanes16(zx, p, e));
+    case 32:
+	return vreinterpretq_u8_u32(ElemP_lanes32(zx, p, e));
+    case 64:
+	return vreinterpretq_u8_u64(ElemP_lanes64(zx, p, e));
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+/* Returns the predicate bytes of a 128-bit segment with all the
+   elements active.  A lane mask is narrowed to the predicate bytes by
+   ANDing with it. */
+
+static uint8x16_t
+ElemP_ones(int esize)
+{
+    /*NEON*/
+    switch (esize) {
+    case 8:
+	return vdupq_n_u8(1U);
+    case 16:
+	return vreinterpretq_u8_u16(vdupq_n_u16(1U));
+    case 32:
+	return vreinterpretq_u8_u32(vdupq_n_u32(1U));
+    case 64:
+	return vreinterpretq_u8_u64(vdupq_n_u64(1ULL));
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
 static bool
 ElemFFR_get(svecxt_t *zx, int e, int esize)
 {
@@ -496,38 +614,117 @@ ElemFFR_set(svecxt_t *zx, int e, int esize, bool value)
     }
 }
 
-static bool
-FirstActive(svecxt_t *zx, preg *mask, preg *x, int esize)
+/* Scans predicates in 64-bit words of the predicate bytes, keeping
+   the lowest byte of each element.  They return the first (at or
+   after the element FROM) or the last element active in both MASK and
+   X, or -1 if none.  Pass the same predicate for MASK and X to scan a
+   single predicate. */
+
+static u64
+preg_word(preg *mask, preg *x, int n, int esize)
 {
-    int elements = zx->PL / (esize / 8);
-    for (int e = 0; e < elements; e++) {
-        if (ElemP_get(zx, mask, e, esize) == 1) {
-	    return ElemP_get(zx, x, e, esize);
+    /*NEON*/
+    u64 lowest = vgetq_lane_u64(vreinterpretq_u64_u8(ElemP_ones(esize)), 0);
+    u64 m, v;
+    memcpy(&m, &mask->k[n], sizeof(u64));
+    memcpy(&v, &x->k[n], sizeof(u64));
+    return (m & v & lowest);
+}
+
+static int
+preg_scan_first(svecxt_t *zx, preg *mask, preg *x, int esize, int from)
+{
+    int psize = esize / 8;
+    int start = (from * psize);
+    for (int n = (start & ~7); n < zx->PL; n += 8) {
+	u64 w = preg_word(mask, x, n, esize);
+	if (n < start) {
+	    w &= (~0ULL << (8 * (start - n)));
+	}
+	if (w != 0) {
+	    return ((n + __builtin_ctzl(w) / 8) / psize);
+	}
+    }
+    return -1;
+}
+
+static int
+preg_scan_last(svecxt_t *zx, preg *mask, preg *x, int esize)
+{
+    int psize = esize / 8;
+    for (int n = (zx->PL - 8); n >= 0; n -= 8) {
+	u64 w = preg_word(mask, x, n, esize);
+	if (w != 0) {
+	    return ((n + (63 - __builtin_clzl(w)) / 8) / psize);
 	}
     }
-    return 0;
+    return -1;
+}
+
+/* Counts the elements active in both MASK and X, by a popcount of the
+   predicate bytes (each active element has one bit set). */
+
+static int
+preg_count(svecxt_t *zx, preg *mask, preg *x, int esize)
+{
+    int count = 0;
+    for (int n = 0; n < zx->PL; n += 8) {
+	count += __builtin_popcountl(preg_word(mask, x, n, esize));
+    }
+    return count;
+}
+
+static bool
+FirstActive(svecxt_t *zx, preg *mask, preg *x, int esize)
+{
+    int e = preg_scan_first(zx, mask, mask, esize, 0);
+    return (e >= 0 && ElemP_get(zx, x, e, esize) == 1);
 }
 
 static bool
 LastActive(svecxt_t *zx, preg *mask, preg *x, int esize)
 {
-    int elements = zx->PL / (esize / 8);
-    for (int e = (elements-1); e >= 0; e--) {
-        if (ElemP_get(zx, mask, e, esize) == 1) {
-	    return ElemP_get(zx, x, e, esize);
+    int e = preg_scan_last(zx, mask, mask, esize);
+    return (e >= 0 && ElemP_get(zx, x, e, esize) == 1);
+}
+
+/* Packs the predicate bytes into bits (a bit for a byte as in the
+   architectural predicate register), keeping the lowest byte of each
+   element.  BITS holds PL bits. */
+
+static void
+preg_pack(svecxt_t *zx, preg *p, int esize, u64 *bits)
+{
+    static const u8 weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+				   1, 2, 4, 8, 16, 32, 64, 128};
+    /*NEON*/
+    uint8x16_t w = vld1q_u8(weights);
+    uint8x16_t ones = ElemP_ones(esize);
+    for (int n = 0; n < zx->PL; n += 64) {
+	u64 word = 0;
+	for (int i = 0; i < 64 && (n + i) < zx->PL; i += 16) {
+	    uint8x16_t v = vandq_u8(vld1q_u8((u8 *)&p->k[n + i]), ones);
+	    uint8x16_t m = vmulq_u8(v, w);
+	    u64 lo = vaddv_u8(vget_low_u8(m));
+	    u64 hi = vaddv_u8(vget_high_u8(m));
+	    word |= ((lo | (hi << 8)) << i);
 	}
+	bits[n / 64] = word;
     }
-    return 0;
 }
 
+/* Finds the last active element by count-leading-zeros on the packed
+   predicate (a single word up to VL=512). */
+
 static int
 LastActiveElement(svecxt_t *zx, preg *mask, int esize)
 {
     assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
-    int elements = zx->VL / esize;
-    for (int e = (elements-1); e >= 0; e--) {
-	if (ElemP_get(zx, mask, e, esize) == 1) {
-	    return e;
+    u64 bits[256 / 64];
+    preg_pack(zx, mask, esize, bits);
+    for (int n = ((zx->PL + 63) / 64 - 1); n >= 0; n--) {
+	if (bits[n] != 0) {
+	    return ((n * 64 + 63 - __builtin_clzl(bits[n])) / (esize / 8));
 	}
     }
     return -1;
@@ -536,14 +733,7 @@ LastActiveElement(svecxt_t *zx, preg *mask, int esize)
 static bool
 NoneActive(svecxt_t *zx, preg *mask, preg *x, int esize)
 {
-    int elements = zx->PL / (esize / 8);
-    for (int e = 0; e < elements; e++) {
-        if (ElemP_get(zx, mask, e, esize) == 1
-	    && ElemP_get(zx, x, e, esize) == 1) {
-	    return 0;
-	}
-    }
-    return 1;
+    return (preg_scan_first(zx, mask, x, esize, 0) == -1);
 }
 
 static bool4
@@ -558,6 +748,53 @@ PredTest(svecxt_t *zx, preg *mask, preg *result, int esize)
     return nzcv;
 }
 
+/* PredTest() accumulated over 128-bit segments, in the same pass as
+   computing a predicate.  G and R are the predicate bytes of the
+   governing and the result predicates of a segment, where G is
+   narrowed to the lowest byte of each element. */
+
+typedef struct {
+    int first;
+    bool firstr;
+    bool lastr;
+    bool anyr;
+} predtest_t;
+
+static const predtest_t predtest_initial = {
+    .first = -1, .firstr = 0, .lastr = 0, .anyr = 0};
+
+static void
+PredTest_segment(predtest_t *t, int base, uint8x16_t g, uint8x16_t r)
+{
+    /*NEON*/
+    uint64x2_t g2 = vreinterpretq_u64_u8(g);
+    uint64x2_t r2 = vreinterpretq_u64_u8(vandq_u8(g, r));
+    u64 g0 = vgetq_lane_u64(g2, 0);
+    u64 g1 = vgetq_lane_u64(g2, 1);
+    u64 r0 = vgetq_lane_u64(r2, 0);
+    u64 r1 = vgetq_lane_u64(r2, 1);
+    t->anyr = (t->anyr || (r0 | r1) != 0);
+    if ((g0 | g1) != 0) {
+	if (t->first == -1) {
+	    int f = ((g0 != 0)
+		     ? __builtin_ctzl(g0) : (64 + __builtin_ctzl(g1)));
+	    t->first = (base + f / 8);
+	    t->firstr = ((f < 64 ? (r0 >> f) : (r1 >> (f - 64))) & 1);
+	}
+	int l = ((g1 != 0)
+		 ? (127 - __builtin_clzl(g1)) : (63 - __builtin_clzl(g0)));
+	l = (l & ~7);
+	t->lastr = ((l < 64 ? (r0 >> l) : (r1 >> (l - 64))) & 1);
+    }
+}
+
+static bool4
+PredTest_result(predtest_t *t)
+{
+    bool4 nzcv = {t->firstr, (! t->anyr), (! t->lastr), 0};
+    return nzcv;
+}
+
 static bool4
 NZCV_get(svecxt_t *zx)
 {
@@ -629,48 +866,6 @@ CeilPow2(int x)
     }
 }
 
-static u64
-FPMulAdd(u64 x0, u64 x1, u64 x2, int esize, int FPCR)
-{
-    switch (esize) {
-    case 32: {
-	float v0 = u64_as_float(x0);
-	float v1 = u64_as_float(x1);
-	float v2 = u64_as_float(x2);
-	float r = v0 + (v1 * v2);
-	return float_as_u64(r);
-    }
-    case 64: {
-	double v0 = u64_as_double(x0);
-	double v1 = u64_as_double(x1);
-	double v2 = u64_as_double(x2);
-	double r = v0 + (v1 * v2);
-	return double_as_u64(r);
-    }
-    default:
-	assert(esize == 32 || esize == 64);
-	abort();
-    }
-}
-
-static u64
-FPNeg(u64 x, int esize)
-{
-    switch (esize) {
-    case 32: {
-	float v = (- u64_as_float(x));
-	return float_as_u64(v);
-    }
-    case 64: {
-	double v = (- u64_as_double(x));
-	return double_as_u64(v);
-    }
-    default:
-	assert(esize == 32 || esize == 64);
-	abort();
-    }
-}
-
 /* Determines the element count for the esize respecting the
    constraint given by the pattern. */
 
@@ -700,13 +895,35 @@ DecodePredCount(svecxt_t *zx, int pattern, int esize)
     }
 }
 
+/* Replicates a value in a 128-bit segment. */
+
+static uint8x16_t
+Replicate_q(int esize, u64 v)
+{
+    /*NEON*/
+    switch (esize) {
+    case 8:
+	return vdupq_n_u8((u8)v);
+    case 16:
+	return vreinterpretq_u8_u16(vdupq_n_u16((u16)v));
+    case 32:
+	return vreinterpretq_u8_u32(vdupq_n_u32((u32)v));
+    case 64:
+	return vreinterpretq_u8_u64(vdupq_n_u64(v));
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
 static zreg
 Replicate_z(svecxt_t *zx, int esize, u64 v)
 {
-    int elements = zx->VL / esize;
     zreg z = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	Elem_set(zx, &z, e, esize, v);
+    /*NEON*/
+    uint8x16_t r = Replicate_q(esize, v);
+    for (int i = 0; i < (zx->VL / 8); i += 16) {
+	vst1q_u8(&z.b[i], r);
     }
     return z;
 }
@@ -773,14 +990,16 @@ esize_for_shift(s64 shift)
 static u64
 FPAbs(int esize, u64 v)
 {
-    union {u64 d; u32 w;} u = {.d = v};
+    union {u64 d; u32 w; u16 h;} u = {.d = v};
     switch (esize) {
+    case 16:
+	return (u64)(u.h & ~0x8000U);
     case 32:
 	return (u64)(u.w & ~0x80000000UL);
     case 64:
 	return (u64)(u.d & ~0x8000000000000000ULL);
     default:
-	assert(esize == 32 || esize == 64);
+	assert(esize == 16 || esize == 32 || esize == 64);
 	abort();
     }
 }
@@ -793,6 +1012,8 @@ constant_f(int esize, double v)
 {
     union {u64 u; double d; float f;} u = {.u = 0ULL};
     switch (esize) {
+    case 16:
+	return (u64)float_to_hf(double_to_float(v));
     case 32:
 	u.f = double_to_float(v);
 	return u.u;
@@ -800,17 +1021,15 @@ constant_f(int esize, double v)
 	u.d = v;
 	return u.u;
     default:
-	assert(esize == 32 || esize == 64);
+	assert(esize == 16 || esize == 32 || esize == 64);
 	abort();
     }
 }
 
-/* It misses the esize=16 case. */
-
 static u64
 VFPExpandImm(int esize, u64 v8)
 {
-    assert(esize == 32 || esize == 64);
+    assert(esize == 16 || esize == 32 || esize == 64);
     int N = esize;
     int E = (N == 16 ? 5 : (N == 32) ? 8 : 11);
     int F = (N - E - 1);
@@ -830,9 +1049,19 @@ FPConvert(u64 v, int srcbits, int dstbits)
     assert(srcbits != dstbits);
     assert(srcbits == 16 || srcbits == 32 || srcbits == 64);
     assert(dstbits == 16 || dstbits == 32 || dstbits == 64);
-    if (srcbits == 16 || dstbits == 16) {
-	assert(srcbits != 16 && dstbits != 16);
-	abort();
+    if (srcbits == 16) {
+	float f = hf_to_float((u16)v);
+	if (dstbits == 32) {
+	    return float_as_u64(f);
+	} else {
+	    return double_as_u64(float_to_double(f));
+	}
+    } else if (dstbits == 16) {
+	if (srcbits == 32) {
+	    return (u64)float_to_hf(u64_as_float(v));
+	} else {
+	    return (u64)double_to_hf(u64_as_double(v));
+	}
     } else if (srcbits == 32 && dstbits == 64) {
 	union {u64 u; double d; float f;} u0 = {.u = 0ULL}, u1 = {.u = 0ULL};
 	u0.u = v;
@@ -849,15 +1078,46 @@ FPConvert(u64 v, int srcbits, int dstbits)
     }
 }
 
-/* The signed case is fine, because cast in C truncates.  The unsigned
-   case is uncertain, and leaves it to the C behavior.  */
+/* It truncates toward zero and saturates.  Half-precision is widened
+   to single-precision, which is exact. */
 
 static u64
 FPToFixed(u64 v, enum signedness signedp, int srcbits, int dstbits)
 {
-    assert(srcbits == 32 || srcbits == 64);
-    assert(dstbits == 32 || dstbits == 64);
+    assert(srcbits == 16 || srcbits == 32 || srcbits == 64);
+    assert(dstbits == 32 || dstbits == 64 || srcbits == 16);
     switch (srcbits) {
+    case 16: {
+	float f = hf_to_float((u16)v);
+	/*NEON*/
+	switch (dstbits) {
+	case 16:
+	    if (signedp == S64EXT) {
+		return s16_to_u64(vqmovns_s32(vcvts_s32_f32(f)));
+	    } else {
+		return u16_to_u64(vqmovns_u32(vcvts_u32_f32(f)));
+	    }
+	    break;
+	case 32:
+	    if (signedp == S64EXT) {
+		return float_to_s32(f);
+	    } else {
+		return float_to_u32(f);
+	    }
+	    break;
+	case 64:
+	    if (signedp == S64EXT) {
+		return float_to_s64(f);
+	    } else {
+		return float_to_u64(f);
+	    }
+	    break;
+	default:
+	    assert(dstbits == 16 || dstbits == 32 || dstbits == 64);
+	    abort();
+	}
+	break;
+    }
     case 32: {
 	switch (dstbits) {
 	case 32:
@@ -908,14 +1168,25 @@ FPToFixed(u64 v, enum signedness signedp, int srcbits, int dstbits)
     }
 }
 
-/* (It rounds by the current mode). */
+/* (It rounds by the current mode).  Half-precision is converted from
+   double-precision, where integers are exact up to 2^53, and larger
+   ones overflow half-precision anyway. */
 
 static u64
 FixedToFP(u64 v, enum signedness signedp, int srcbits, int dstbits)
 {
-    assert(srcbits == 32 || srcbits == 64);
-    assert(dstbits == 32 || dstbits == 64);
+    assert(srcbits == 16 || srcbits == 32 || srcbits == 64);
+    assert(dstbits == 16 || dstbits == 32 || dstbits == 64);
     switch (dstbits) {
+    case 16: {
+	u64 x = sign_extend(v, srcbits, signedp);
+	if (signedp == S64EXT) {
+	    return (u64)double_to_hf(s64_to_double((s64)x));
+	} else {
+	    return (u64)double_to_hf(u64_to_double(x));
+	}
+	break;
+    }
     case 32: {
 	switch (srcbits) {
 	case 32:
@@ -961,7 +1232,7 @@ FixedToFP(u64 v, enum signedness signedp, int srcbits, int dstbits)
 	break;
     }
     default:
-	assert(dstbits == 32 || dstbits == 64);
+	assert(dstbits == 16 || dstbits == 32 || dstbits == 64);
 	abort();
     }
 }
@@ -992,30 +1263,153 @@ FPDefaultNaN(int esize)
     return ((sign << (E + F)) | (expn << F) | frac);
 }
 
-/* Reverses a predicate vector. */
+/* Byte permutes.  A permute is given by a byte index vector, where
+   an index of a result byte is a byte position in the first source,
+   or in the second source offset by PERMUTE_SECOND, or PERMUTE_ZERO
+   to zero it.  The indices are fixed by the operation, esize and VL
+   for ZIP/UZP/TRN/REV, and they are computed once and cached.  A
+   permute runs as NEON table lookups over 64-byte pieces of the
+   sources.  The layout of a predicate is the same as a vector (a byte
+   for a byte), and the same indices are used for predicates. */
 
-static preg
-reverse_preg(svecxt_t *zx, int esize, preg x)
+#define PERMUTE_SECOND 256
+#define PERMUTE_ZERO 0xffff
+
+typedef enum {Perm_ZIP1, Perm_ZIP2, Perm_UZP1, Perm_UZP2,
+	      Perm_TRN1, Perm_TRN2, Perm_REV, Perm_OPS} Perm;
+
+typedef struct {
+    int vl;
+    u16 index[256];
+} permute_t;
+
+static permute_t permute_tables[Perm_OPS][4];
+
+static void
+permute_index(svecxt_t *zx, Perm op, int esize, u16 *index)
 {
     int elements = zx->VL / esize;
-    preg result = preg_zeros;
+    int ebytes = esize / 8;
+    int half = elements / 2;
     for (int e = 0; e < elements; e++) {
-	bool v = ElemP_get(zx, &x, e, esize);
-        ElemP_set(zx, &result, (elements - 1 - e), esize, v);
+	int s;
+	int x;
+	switch (op) {
+	case Perm_ZIP1:
+	case Perm_ZIP2:
+	    s = (e % 2);
+	    x = ((op == Perm_ZIP1) ? 0 : half) + (e / 2);
+	    break;
+	case Perm_UZP1:
+	case Perm_UZP2:
+	    s = ((e < half) ? 0 : 1);
+	    x = (2 * (e - s * half) + ((op == Perm_UZP1) ? 0 : 1));
+	    break;
+	case Perm_TRN1:
+	case Perm_TRN2:
+	    s = (e % 2);
+	    x = ((e & ~1) + ((op == Perm_TRN1) ? 0 : 1));
+	    break;
+	case Perm_REV:
+	    s = 0;
+	    x = (elements - 1 - e);
+	    break;
+	default:
+	    assert(op < Perm_OPS);
+	    abort();
+	}
+	for (int j = 0; j < ebytes; j++) {
+	    index[e * ebytes + j] = (u16)(s * PERMUTE_SECOND + x * ebytes + j);
+	}
+    }
+}
+
+/* Returns the cached indices, or computes them in SCRATCH when the
+   cache is filled for a different VL. */
+
+static const u16 *
+permute_table(svecxt_t *zx, Perm op, int esize, permute_t *scratch)
+{
+    permute_t *t = &permute_tables[op][__builtin_ctz((unsigned)esize) - 3];
+    if (t->vl == 0) {
+	mutex_enter(&mutex);
+	mb();
+	if (t->vl == 0) {
+	    permute_index(zx, op, esize, t->index);
+	    mb();
+	    t->vl = zx->VL;
+	}
+	mb();
+	mutex_leave(&mutex);
+    }
+    if (t->vl == zx->VL) {
+	return t->index;
+    } else {
+	permute_index(zx, op, esize, scratch->index);
+	return scratch->index;
     }
-    return result;
 }
 
-/* Reverses a zreg vector. */
+/* Permutes the bytes of A and B (B may be null for a single source)
+   into OUT.  OUT shall not overlap the sources. */
+
+static void
+permute_bytes(svecxt_t *zx, const u16 *index,
+	      const u8 *a, const u8 *b, u8 *out)
+{
+    int bytes = zx->VL / 8;
+    int pieces = ((bytes + 63) / 64);
+    /*NEON*/
+    for (int i = 0; i < bytes; i += 16) {
+	uint16x8_t i0 = vld1q_u16(&index[i]);
+	uint16x8_t i1 = vld1q_u16(&index[i + 8]);
+	uint8x16_t r = vdupq_n_u8(0);
+	for (int s = 0; s < 2; s++) {
+	    const u8 *v = ((s == 0) ? a : b);
+	    if (v == 0) {
+		continue;
+	    }
+	    for (int k = 0; k < pieces; k++) {
+		uint16x8_t base = vdupq_n_u16((u16)(s * PERMUTE_SECOND + 64 * k));
+		uint8x16_t local = vcombine_u8(vqmovn_u16(vsubq_u16(i0, base)),
+					       vqmovn_u16(vsubq_u16(i1, base)));
+		uint8x16x4_t table = {{vld1q_u8(&v[64 * k]),
+				       vld1q_u8(&v[64 * k + 16]),
+				       vld1q_u8(&v[64 * k + 32]),
+				       vld1q_u8(&v[64 * k + 48])}};
+		r = vqtbx4q_u8(r, table, local);
+	    }
+	}
+	vst1q_u8(&out[i], r);
+    }
+}
 
 static zreg
-reverse_zreg(svecxt_t *zx, int esize, zreg x)
+permute_zreg(svecxt_t *zx, Perm op, int esize, zreg *a, zreg *b)
 {
-    int elements = zx->VL / esize;
+    permute_t scratch;
+    const u16 *index = permute_table(zx, op, esize, &scratch);
     zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 v = Elem_get(zx, &x, e, esize, DONTCARE);
-	Elem_set(zx, &result, (elements - 1 - e), esize, v);
+    permute_bytes(zx, index, a->b, ((b != 0) ? b->b : 0), result.b);
+    return result;
+}
+
+/* Permutes predicates.  It clears the bytes other than the lowest of
+   each element, which are not zero in a predicate made for a smaller
+   esize. */
+
+static preg
+permute_preg(svecxt_t *zx, Perm op, int esize, preg *a, preg *b)
+{
+    permute_t scratch;
+    const u16 *index = permute_table(zx, op, esize, &scratch);
+    preg result = preg_zeros;
+    u8 *r = (u8 *)result.k;
+    permute_bytes(zx, index, (u8 *)a->k, ((b != 0) ? (u8 *)b->k : 0), r);
+    /*NEON*/
+    uint8x16_t ones = ElemP_ones(esize);
+    for (int i = 0; i < zx->PL; i += 16) {
+	vst1q_u8(&r[i], vandq_u8(vld1q_u8(&r[i]), ones));
     }
     return result;
 }
@@ -1310,6 +1704,9 @@ typedef enum {Fop_ADD, Fop_SUB, Fop_SUB_REV,
 	      Fop_MAX, Fop_MIN, Fop_MAXNUM, Fop_MINNUM,
 	      Fop_NEG, Fop_ABS, Fop_SQRT,
 	      Fop_RECPE, Fop_RECPS, Fop_RSQRTE, Fop_RSQRTS,
+	      Fop_RECPX, Fop_MULX,
+	      Fop_RINTA, Fop_RINTI, Fop_RINTM, Fop_RINTN,
+	      Fop_RINTP, Fop_RINTX, Fop_RINTZ,
 	      Fop_DIFF, Fop_CPY,
 	      Fop_CVT_16_32, Fop_CVT_16_64, Fop_CVT_32_16,
 	      Fop_CVT_32_64, Fop_CVT_64_16, Fop_CVT_64_32,
@@ -1320,7 +1717,11 @@ typedef enum {Fop_ADD, Fop_SUB, Fop_SUB_REV,
 	      Fop_CVTF_S32_32, Fop_CVTF_S32_64,
 	      Fop_CVTF_S64_32, Fop_CVTF_S64_64,
 	      Fop_CVTF_U32_32, Fop_CVTF_U32_64,
-	      Fop_CVTF_U64_32, Fop_CVTF_U64_64} Fop;
+	      Fop_CVTF_U64_32, Fop_CVTF_U64_64,
+	      Fop_CVTI_16_S16, Fop_CVTI_16_S32, Fop_CVTI_16_S64,
+	      Fop_CVTI_16_U16, Fop_CVTI_16_U32, Fop_CVTI_16_U64,
+	      Fop_CVTF_S16_16, Fop_CVTF_S32_16, Fop_CVTF_S64_16,
+	      Fop_CVTF_U16_16, Fop_CVTF_U32_16, Fop_CVTF_U64_16} Fop;
 
 /* Accesses X registers, handling X31 which is not saved in the
    mcontext. */
@@ -1389,19 +1790,253 @@ perform_NOP()
     /*NOP*/
 }
 
-/* Helper Functions. */
+/* GATHER/SCATTER.  Gathers and scatters first compute the addresses
+   of all the elements at once.  Then, the active elements are split
+   into runs, where a run is unit-stride or constant-stride, or its
+   addresses fall in the same cache line.  A run is served by a
+   single block access.  The span of a block is bounded by
+   GATHER_SPAN_MAX, so that a block access does not touch a page
+   which the elements of the run do not touch.  The remaining
+   irregular elements are prefetched while splitting, and then
+   accessed one by one.  Scatters only take unit-stride runs, because
+   they may not write the gaps, and they write in the element order,
+   so that the highest-numbered one wins when elements conflict. */
+
+#define GATHER_LINE_SIZE (64)
+#define GATHER_SPAN_MAX (256)
+#define GATHER_ELEMENTS_MAX (2048 / 32)
+
+typedef struct {int n; int span; u64 lo;} gather_run_t;
+
+/* Computes the addresses of scalar plus vector for all the elements.
+   An offset of OSIZE bits is taken from the low bits of an element,
+   and is extended and scaled. */
 
 static void
-perform_LD1_x_x_mode(svecxt_t *zx, int esize, int msize, bool unsignedp,
-		     int Zt, int Rn, int Rm, int Pg, AccType ac)
+gather_addresses_x_z(svecxt_t *zx, int esize, int osize, bool ounsignedp,
+		     int scale, u64 base, zreg *offset, u64 *addrs)
 {
-    assert(zx != 0 && zx->ux != 0);
-    /*mcontext_t *ux = zx->ux;*/
-    CheckSVEEnabled();
-
     int elements = zx->VL / esize;
-    u64 base;
-    u64 addr;
+    /*NEON*/
+    int64x2_t vbase = vdupq_n_s64((s64)base);
+    int64x2_t vscale = vdupq_n_s64(scale);
+    if (esize == 64) {
+	assert(osize == 32 || osize == 64);
+	for (int e = 0; e < elements; e += 2) {
+	    int64x2_t off = vld1q_s64((s64 *)&offset->x[e]);
+	    if (osize == 32 && ounsignedp) {
+		uint64x2_t m = vdupq_n_u64(0xffffffffULL);
+		off = vreinterpretq_s64_u64(vandq_u64(vreinterpretq_u64_s64(off), m));
+	    } else if (osize == 32) {
+		off = vshrq_n_s64(vshlq_n_s64(off, 32), 32);
+	    }
+	    int64x2_t a = vaddq_s64(vbase, vshlq_s64(off, vscale));
+	    vst1q_u64(&addrs[e], vreinterpretq_u64_s64(a));
+	}
+    } else {
+	assert(esize == 32 && osize == 32);
+	for (int e = 0; e < elements; e += 4) {
+	    int64x2_t off0;
+	    int64x2_t off1;
+	    if (ounsignedp) {
+		uint32x4_t v = vld1q_u32(&offset->w[e]);
+		off0 = vreinterpretq_s64_u64(vmovl_u32(vget_low_u32(v)));
+		off1 = vreinterpretq_s64_u64(vmovl_high_u32(v));
+	    } else {
+		int32x4_t v = vld1q_s32((s32 *)&offset->w[e]);
+		off0 = vmovl_s32(vget_low_s32(v));
+		off1 = vmovl_high_s32(v);
+	    }
+	    int64x2_t a0 = vaddq_s64(vbase, vshlq_s64(off0, vscale));
+	    int64x2_t a1 = vaddq_s64(vbase, vshlq_s64(off1, vscale));
+	    vst1q_u64(&addrs[e], vreinterpretq_u64_s64(a0));
+	    vst1q_u64(&addrs[e + 2], vreinterpretq_u64_s64(a1));
+	}
+    }
+}
+
+/* Computes the addresses of vector plus immediate for all the
+   elements.  OFFSET is in bytes. */
+
+static void
+gather_addresses_z_imm(svecxt_t *zx, int esize, zreg *base, s64 offset,
+		       u64 *addrs)
+{
+    int elements = zx->VL / esize;
+    /*NEON*/
+    uint64x2_t voff = vdupq_n_u64((u64)offset);
+    if (esize == 64) {
+	for (int e = 0; e < elements; e += 2) {
+	    uint64x2_t a = vaddq_u64(vld1q_u64(&base->x[e]), voff);
+	    vst1q_u64(&addrs[e], a);
+	}
+    } else {
+	assert(esize == 32);
+	for (int e = 0; e < elements; e += 4) {
+	    uint32x4_t v = vld1q_u32(&base->w[e]);
+	    uint64x2_t a0 = vaddq_u64(vmovl_u32(vget_low_u32(v)), voff);
+	    uint64x2_t a1 = vaddq_u64(vmovl_high_u32(v), voff);
+	    vst1q_u64(&addrs[e], a0);
+	    vst1q_u64(&addrs[e + 2], a1);
+	}
+    }
+}
+
+/* Finds a run of active elements starting at E.  It returns the run
+   in RUN, whose length is one for an irregular element.  UNITP
+   restricts runs to unit-stride ones. */
+
+static void
+gather_find_run(svecxt_t *zx, int esize, preg *mask, u64 *addrs,
+		int mbytes, bool unitp, int e, gather_run_t *run)
+{
+    int elements = zx->VL / esize;
+    u64 lo = addrs[e];
+    u64 hi = addrs[e] + (u64)mbytes;
+    s64 stride = 0;
+    bool stridedp = true;
+    int n = 1;
+    while (e + n < elements && ElemP_get(zx, mask, (e + n), esize) == 1) {
+	u64 a = addrs[e + n];
+	s64 d = (s64)(a - addrs[e + n - 1]);
+	if (n == 1) {
+	    stride = d;
+	}
+	stridedp = (stridedp && d == stride);
+	u64 lo1 = ((a < lo) ? a : lo);
+	u64 hi1 = (((a + (u64)mbytes) > hi) ? (a + (u64)mbytes) : hi);
+	bool linep = (align_down(lo1, GATHER_LINE_SIZE)
+		      == align_down((hi1 - 1), GATHER_LINE_SIZE));
+	bool ok;
+	if (unitp) {
+	    ok = (stridedp && stride == mbytes);
+	} else {
+	    ok = ((stridedp || linep) && (hi1 - lo1) <= GATHER_SPAN_MAX);
+	}
+	if (!ok) {
+	    break;
+	}
+	lo = lo1;
+	hi = hi1;
+	n++;
+    }
+    run->n = n;
+    run->lo = lo;
+    run->span = (int)(hi - lo);
+}
+
+/* Splits the active elements into runs.  RUNS[E] is set at the start
+   of a run, and RUNS[E].N is zero for an inactive element.
+   Irregular elements are prefetched here, ahead of the accesses. */
+
+static void
+gather_split_runs(svecxt_t *zx, int esize, preg *mask, u64 *addrs,
+		  int mbytes, bool storep, gather_run_t *runs)
+{
+    int elements = zx->VL / esize;
+    int e = 0;
+    while (e < elements) {
+	if (ElemP_get(zx, mask, e, esize) == 0) {
+	    runs[e].n = 0;
+	    e++;
+	    continue;
+	}
+	gather_find_run(zx, esize, mask, addrs, mbytes, storep, e, &runs[e]);
+	if (runs[e].n == 1) {
+	    if (storep) {
+		__builtin_prefetch((void *)addrs[e], 1, 0);
+	    } else {
+		__builtin_prefetch((void *)addrs[e], 0, 0);
+	    }
+	}
+	e += runs[e].n;
+    }
+}
+
+/* Loads the active elements from the addresses and zeros the
+   inactive ones. */
+
+static void
+gather_rd(svecxt_t *zx, int esize, int msize, bool unsignedp,
+	  u64 *addrs, preg *mask, zreg *result)
+{
+    int elements = zx->VL / esize;
+    int mbytes = msize / 8;
+    assert(elements <= GATHER_ELEMENTS_MAX);
+    gather_run_t runs[GATHER_ELEMENTS_MAX];
+    u8 block[GATHER_SPAN_MAX];
+    gather_split_runs(zx, esize, mask, addrs, mbytes, false, runs);
+    int e = 0;
+    while (e < elements) {
+	int n = runs[e].n;
+	if (n == 0) {
+	    Elem_set(zx, result, e, esize, 0ULL);
+	    e++;
+	} else if (n == 1) {
+	    u64 data = Mem_rd(zx, addrs[e], mbytes, unsignedp, AccType_NORMAL);
+	    Elem_set(zx, result, e, esize, data);
+	    e++;
+	} else {
+	    u64 lo = runs[e].lo;
+	    memcpy(block, (void *)lo, (size_t)runs[e].span);
+	    for (int i = e; i < (e + n); i++) {
+		u64 a = (u64)&block[addrs[i] - lo];
+		u64 data = Mem_rd(zx, a, mbytes, unsignedp, AccType_NORMAL);
+		Elem_set(zx, result, i, esize, data);
+	    }
+	    e += n;
+	}
+    }
+}
+
+/* Stores the active elements to the addresses in the element
+   order. */
+
+static void
+scatter_wr(svecxt_t *zx, int esize, int msize,
+	   u64 *addrs, preg *mask, zreg *src)
+{
+    int elements = zx->VL / esize;
+    int mbytes = msize / 8;
+    assert(elements <= GATHER_ELEMENTS_MAX);
+    gather_run_t runs[GATHER_ELEMENTS_MAX];
+    u8 block[GATHER_SPAN_MAX];
+    gather_split_runs(zx, esize, mask, addrs, mbytes, true, runs);
+    int e = 0;
+    while (e < elements) {
+	int n = runs[e].n;
+	if (n == 0) {
+	    e++;
+	} else if (n == 1) {
+	    u64 data = Elem_get(zx, src, e, esize, DONTCARE);
+	    Mem_wr(zx, addrs[e], mbytes, data, AccType_NORMAL);
+	    e++;
+	} else {
+	    u64 lo = runs[e].lo;
+	    for (int i = e; i < (e + n); i++) {
+		u64 a = (u64)&block[addrs[i] - lo];
+		u64 data = Elem_get(zx, src, i, esize, DONTCARE);
+		Mem_wr(zx, a, mbytes, data, AccType_NORMAL);
+	    }
+	    memcpy((void *)lo, block, (size_t)runs[e].span);
+	    e += n;
+	}
+    }
+}
+
+/* Helper Functions. */
+
+static void
+perform_LD1_x_x_mode(svecxt_t *zx, int esize, int msize, bool unsignedp,
+		     int Zt, int Rn, int Rm, int Pg, AccType ac)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int elements = zx->VL / esize;
+    u64 base;
+    u64 addr;
     preg mask = zx->p[Pg];
     zreg result = zreg_zeros;
     u64 data;
@@ -1438,25 +2073,15 @@ perform_LD1_x_z(svecxt_t *zx, int esize, int msize, bool munsignedp,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
     u64 base;
-    u64 addr;
     zreg offset = zx->z[Zm];
     preg mask = zx->p[Pg];
     zreg result = zreg_zeros;
-    u64 data;
-    int mbytes = msize / 8;
+    u64 addrs[GATHER_ELEMENTS_MAX];
     base = Xreg_get(zx, Rn, X31SP);
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    s64 off = (s64)Elem_get(zx, &offset, e, osize, ounsignedp);
-	    addr = (u64)((s64)base + (off << scale));
-	    data = Mem_rd(zx, addr, mbytes, munsignedp, AccType_NORMAL);
-	    Elem_set(zx, &result, e, esize, data);
-	} else {
-	    Elem_set(zx, &result, e, esize, 0ULL);
-	}
-    }
+    gather_addresses_x_z(zx, esize, osize, ounsignedp, scale,
+			 base, &offset, addrs);
+    gather_rd(zx, esize, msize, munsignedp, addrs, &mask, &result);
     zx->z[Zt] = result;
 }
 
@@ -1505,23 +2130,13 @@ perform_LD1_z_imm(svecxt_t *zx, int esize, int msize, bool unsignedp,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
     zreg base = zx->z[Zn];
-    u64 addr;
     preg mask = zx->p[Pg];
     zreg result = zreg_zeros;
-    u64 data;
+    u64 addrs[GATHER_ELEMENTS_MAX];
     int mbytes = msize / 8;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 base0 = Elem_get(zx, &base, e, esize, U64EXT);
-	    addr = (u64)((s64)base0 + offset * mbytes);
-	    data = Mem_rd(zx, addr, mbytes, unsignedp, AccType_NORMAL);
-	    Elem_set(zx, &result, e, esize, data);
-	} else {
-	    Elem_set(zx, &result, e, esize, 0);
-	}
-    }
+    gather_addresses_z_imm(zx, esize, &base, (offset * mbytes), addrs);
+    gather_rd(zx, esize, msize, unsignedp, addrs, &mask, &result);
     zx->z[Zt] = result;
 }
 
@@ -1603,32 +2218,83 @@ perform_LD1R(svecxt_t *zx, int esize, int msize, bool unsignedp,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
+    int ebytes = esize / 8;
     u64 base;
     u64 addr;
-    preg mask = zx->p[Pg];
+    preg *mask = &zx->p[Pg];
     zreg result = zreg_zeros;
-    u64 data;
     int mbytes = msize / 8;
     base = Xreg_get(zx, Rn, X31SP);
-    int last = LastActiveElement(zx, &mask, esize);
+    int last = LastActiveElement(zx, mask, esize);
     if (last >= 0) {
 	addr = (u64)((s64)base + offset * mbytes);
-	data = Mem_rd(zx, addr, mbytes, unsignedp, AccType_NORMAL);
-    } else {
-	/* (data unsed). */
-	data = 0;
+	u64 data = Mem_rd(zx, addr, mbytes, unsignedp, AccType_NORMAL);
+	/*NEON*/
+	uint8x16_t r = Replicate_q(esize, data);
+	for (int i = 0; i < (zx->VL / 8); i += 16) {
+	    uint8x16_t m = ElemP_lanes(zx, mask, (i / ebytes), esize);
+	    vst1q_u8(&result.b[i], vandq_u8(r, m));
+	}
     }
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    Elem_set(zx, &result, e, esize, data);
-	} else {
-	    Elem_set(zx, &result, e, esize, 0);
+    zx->z[Zt] = result;
+}
+
+/* Load-and-replicate a quadword.  The first 128-bit segment of the
+   predicate governs the elements.  A fully active quadword is read
+   by one load, and otherwise only the active elements are read. */
+
+static void
+perform_LD1RQ(svecxt_t *zx, int esize, int Zt, u64 addr, int Pg)
+{
+    int ebytes = esize / 8;
+    preg *mask = &zx->p[Pg];
+    u8 q[16];
+    /*NEON*/
+    uint8x16_t m = ElemP_lanes(zx, mask, 0, esize);
+    if (vminvq_u8(m) == 0xffU) {
+	memcpy(q, (void *)addr, sizeof(q));
+    } else {
+	memset(q, 0, sizeof(q));
+	for (int e = 0; e < (16 / ebytes); e++) {
+	    if (ElemP_get(zx, mask, e, esize) == 1) {
+		memcpy(&q[e * ebytes], (void *)(addr + (u64)(e * ebytes)),
+		       (size_t)ebytes);
+	    }
 	}
     }
+    uint8x16_t v = vandq_u8(vld1q_u8(q), m);
+    zreg result = zreg_zeros;
+    for (int i = 0; i < (zx->VL / 8); i += 16) {
+	vst1q_u8(&result.b[i], v);
+    }
     zx->z[Zt] = result;
 }
 
+static void
+perform_LD1RQ_x_x(svecxt_t *zx, int esize, int Zt, int Rn, int Rm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    u64 base = Xreg_get(zx, Rn, X31SP);
+    s64 offset = (s64)Xreg_get(zx, Rm, X31ZERO);
+    u64 addr = (u64)((s64)base + offset * (esize / 8));
+    perform_LD1RQ(zx, esize, Zt, addr, Pg);
+}
+
+static void
+perform_LD1RQ_x_imm(svecxt_t *zx, int esize, int Zt, int Rn, s64 imm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    u64 base = Xreg_get(zx, Rn, X31SP);
+    u64 addr = (u64)((s64)base + imm * 16);
+    perform_LD1RQ(zx, esize, Zt, addr, Pg);
+}
+
 static void
 perform_LDFF_x_x(svecxt_t *zx, int esize, int msize, bool unsignedp,
 		 int Zt, int Rn, int Rm, int Pg)
@@ -1853,19 +2519,24 @@ perform_LDR_p(svecxt_t *zx, int Pt, int Rn, s64 imm)
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
+    static const u8 weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+				   1, 2, 4, 8, 16, 32, 64, 128};
     int elements = zx->PL / 8;
     u64 base;
     s64 offset = imm * elements;
     preg result = preg_zeros;
     base = Xreg_get(zx, Rn, X31SP);
-    CheckAlignment((u64)((s64)base + offset), 2, AccType_NORMAL);
-    for (int e = 0; e < elements; e++) {
-	u8 p = (u8)Mem_rd(zx, (base + (u64)offset), 1, U64EXT, AccType_NORMAL);
-	for (int b = 0; b < 8; b++) {
-	    bool v = ((p & (1 << b)) != 0);
-	    ElemP_set(zx, &result, ((8 * e) + b), 8, v);
-	}
-	offset = offset + 1;
+    u64 addr = (u64)((s64)base + offset);
+    CheckAlignment(addr, 2, AccType_NORMAL);
+    u8 bits[256 / 8];
+    memcpy(bits, (void *)addr, (size_t)elements);
+    /* Expands a bit to a byte, two bytes at a time. */
+    /*NEON*/
+    uint8x16_t w = vld1q_u8(weights);
+    for (int e = 0; e < elements; e += 2) {
+	uint8x16_t v = vcombine_u8(vdup_n_u8(bits[e]), vdup_n_u8(bits[e + 1]));
+	uint8x16_t p = vandq_u8(vtstq_u8(v, w), vdupq_n_u8(1U));
+	vst1q_u8((u8 *)&result.k[8 * e], p);
     }
     zx->p[Pt] = result;
 }
@@ -1884,12 +2555,9 @@ perform_LDR_z(svecxt_t *zx, int Zt, int Rn, s64 imm)
     s64 offset = imm * elements;
     zreg result = zreg_zeros;
     base = Xreg_get(zx, Rn, X31SP);
-    CheckAlignment((u64)((s64)base + offset), 16, AccType_NORMAL);
-    for (int e = 0; e < elements; e++) {
-	u64 data = Mem_rd(zx, (u64)((s64)base + offset), 1, DONTCARE, AccType_NORMAL);
-	Elem_set(zx, &result, e, 8, data);
-	offset = offset + 1;
-    }
+    u64 addr = (u64)((s64)base + offset);
+    CheckAlignment(addr, 16, AccType_NORMAL);
+    memcpy(&result.b[0], (void *)addr, (size_t)elements);
     zx->z[Zt] = result;
 }
 
@@ -1936,23 +2604,15 @@ perform_ST1_x_z(svecxt_t *zx, int esize, int msize,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
     u64 base;
     zreg offset = zx->z[Zm];
     zreg src = zx->z[Zt];
     preg mask = zx->p[Pg];
-    u64 addr;
-
-    int mbytes = msize / 8;
+    u64 addrs[GATHER_ELEMENTS_MAX];
     base = Xreg_get(zx, Rn, X31SP);
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    s64 off = (s64)Elem_get(zx, &offset, e, osize, ounsignedp);
-	    addr = (u64)((s64)base + (off << scale));
-	    u64 data = Elem_get(zx, &src, e, esize, DONTCARE);
-	    Mem_wr(zx, addr, mbytes, data, AccType_NORMAL);
-	}
-    }
+    gather_addresses_x_z(zx, esize, osize, ounsignedp, scale,
+			 base, &offset, addrs);
+    scatter_wr(zx, esize, msize, addrs, &mask, &src);
 }
 
 static void
@@ -1997,20 +2657,13 @@ perform_ST1_z_imm(svecxt_t *zx, int esize, int msize,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
     zreg base = zx->z[Zn];
     zreg src = zx->z[Zt];
     preg mask = zx->p[Pg];
-    u64 addr;
+    u64 addrs[GATHER_ELEMENTS_MAX];
     int mbytes = msize / 8;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 base0 = Elem_get(zx, &base, e, esize, U64EXT);
-	    addr = (u64)((s64)base0 + offset * mbytes);
-	    u64 data = Elem_get(zx, &src, e, esize, U64EXT);
-	    Mem_wr(zx, addr, mbytes, data, AccType_NORMAL);
-	}
-    }
+    gather_addresses_z_imm(zx, esize, &base, (offset * mbytes), addrs);
+    scatter_wr(zx, esize, msize, addrs, &mask, &src);
 }
 
 static void
@@ -2102,23 +2755,14 @@ perform_STR_p(svecxt_t *zx, int Pt, int Rn, s64 imm)
     CheckSVEEnabled();
 
     int elements = zx->PL / 8;
-    preg src;
     u64 base;
     s64 offset = imm * elements;
     base = Xreg_get(zx, Rn, X31SP);
-    src = zx->p[Pt];
-    CheckAlignment((u64)((s64)base + offset), 2, AccType_NORMAL);
-    for (int e = 0; e < elements; e++) {
-	u64 data;
-	data = 0;
-	for (int b = 0; b < 8; b++) {
-	    if (ElemP_get(zx, &src, ((8 * e) + b), 8) == 1) {
-		data |= (1UL << b);
-	    }
-	}
-	Mem_wr(zx, (u64)((s64)base + offset), 1, data, AccType_NORMAL);
-	offset = offset + 1;
-    }
+    u64 addr = (u64)((s64)base + offset);
+    CheckAlignment(addr, 2, AccType_NORMAL);
+    u64 bits[256 / 64];
+    preg_pack(zx, &zx->p[Pt], 8, bits);
+    memcpy((void *)addr, bits, (size_t)elements);
 }
 
 static void
@@ -2129,17 +2773,12 @@ perform_STR_z(svecxt_t *zx, int Zt, int Rn, s64 imm)
     CheckSVEEnabled();
 
     int elements = zx->VL / 8;
-    zreg src = zreg_zeros;
     u64 base;
     s64 offset = imm * elements;
     base = Xreg_get(zx, Rn, X31SP);
-    src = zx->z[Zt];
-    CheckAlignment((u64)((s64)base + offset), 16, AccType_NORMAL);
-    for (int e = 0; e < elements; e++) {
-	u64 data = Elem_get(zx, &src, e, 8, DONTCARE);
-	Mem_wr(zx, (u64)((s64)base + offset), 1, data, AccType_NORMAL);
-	offset = offset + 1;
-    }
+    u64 addr = (u64)((s64)base + offset);
+    CheckAlignment(addr, 16, AccType_NORMAL);
+    memcpy((void *)addr, &zx->z[Zt].b[0], (size_t)elements);
 }
 
 /* Reverses predicate elements. */
@@ -2152,7 +2791,7 @@ perform_VECTOR_REVERSE_p(svecxt_t *zx, int esize, int Pd, int Pn)
     CheckSVEEnabled();
 
     preg operand = zx->p[Pn];
-    preg result = reverse_preg(zx, esize, operand);
+    preg result = permute_preg(zx, Perm_REV, esize, &operand, 0);
     zx->p[Pd] = result;
 }
 
@@ -2166,7 +2805,7 @@ perform_VECTOR_REVERSE_z(svecxt_t *zx, int esize, int Zd, int Zn)
     CheckSVEEnabled();
 
     zreg operand = zx->z[Zn];
-    zreg result = reverse_zreg(zx, esize, operand);
+    zreg result = permute_zreg(zx, Perm_REV, esize, &operand, 0);
     zx->z[Zd] = result;
 }
 
@@ -2178,17 +2817,8 @@ perform_ZIP_p(svecxt_t *zx, int esize, int part,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int pairs = zx->VL / (esize * 2);
-    preg operand1 = zx->p[Pn];
-    preg operand2 = zx->p[Pm];
-    preg result = preg_zeros;
-    int base = part * pairs;
-    for (int p = 0; p < pairs; p++) {
-	bool e0 = ElemP_get(zx, &operand1, (base + p), esize);
-	ElemP_set(zx, &result, (2 * p + 0), esize, e0);
-	bool e1 = ElemP_get(zx, &operand2, (base + p), esize);
-	ElemP_set(zx, &result, (2 * p + 1), esize, e1);
-    }
+    Perm op = ((part == 0) ? Perm_ZIP1 : Perm_ZIP2);
+    preg result = permute_preg(zx, op, esize, &zx->p[Pn], &zx->p[Pm]);
     zx->p[Pd] = result;
 }
 
@@ -2200,17 +2830,8 @@ perform_ZIP_z(svecxt_t *zx, int esize, int part,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int pairs = zx->VL / (esize * 2);
-    zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    int base = part * pairs;
-    for (int p = 0; p < pairs; p++) {
-	u64 e0 = Elem_get(zx, &operand1, (base + p), esize, DONTCARE);
-	Elem_set(zx, &result, (2 * p + 0), esize, e0);
-	u64 e1 = Elem_get(zx, &operand2, (base + p), esize, DONTCARE);
-	Elem_set(zx, &result, (2 * p + 1), esize, e1);
-    }
+    Perm op = ((part == 0) ? Perm_ZIP1 : Perm_ZIP2);
+    zreg result = permute_zreg(zx, op, esize, &zx->z[Zn], &zx->z[Zm]);
     zx->z[Zd] = result;
 }
 
@@ -2221,17 +2842,8 @@ perform_UNZIP_p(svecxt_t *zx, int esize, int part, int Pm, int Pn, int Pd)
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
-    preg operand1 = zx->p[Pn];
-    preg operand2 = zx->p[Pm];
-    preg result = preg_zeros;
-    preg zipped[2] = {operand1, operand2};
-    for (int e = 0; e < elements; e++) {
-	int pos0 = ((e < (elements / 2)) ? 0 : 1);
-	int pos1 = ((e < (elements / 2)) ? (2 * e) : (2 * e - elements));
-	bool p = ElemP_get(zx, &zipped[pos0], (pos1 + part), esize);
-	ElemP_set(zx, &result, e, esize, p);
-    }
+    Perm op = ((part == 0) ? Perm_UZP1 : Perm_UZP2);
+    preg result = permute_preg(zx, op, esize, &zx->p[Pn], &zx->p[Pm]);
     zx->p[Pd] = result;
 }
 
@@ -2242,170 +2854,420 @@ perform_UNZIP_z(svecxt_t *zx, int esize, int part, int Zd, int Zn, int Zm)
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
-    zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    zreg zipped[2] = {operand1, operand2};
-    for (int e = 0; e < elements; e++) {
-	int pos0 = ((e < (elements / 2)) ? 0 : 1);
-	int pos1 = ((e < (elements / 2)) ? (2 * e) : (2 * e - elements));
-	u64 v = Elem_get(zx, &zipped[pos0], (pos1 + part), esize, DONTCARE);
-	Elem_set(zx, &result, e, esize, v);
-    }
+    Perm op = ((part == 0) ? Perm_UZP1 : Perm_UZP2);
+    zreg result = permute_zreg(zx, op, esize, &zx->z[Zn], &zx->z[Zm]);
     zx->z[Zd] = result;
 }
 
 static void
-perform_UNPACK_p(svecxt_t *zx, int esize, int hi,
-		 int Pn, int Pd)
+perform_TRN_p(svecxt_t *zx, int esize, int part, int Pn, int Pm, int Pd)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    assert(esize >= 16);
-    int elements = zx->VL / esize;
-    preg operand = zx->p[Pn];
-    preg result = preg_zeros;
-    for (int e = 0; e < elements; e++) {
-	int pos = (hi ? (e + elements) : e);
-	bool p = ElemP_get(zx, &operand, pos, (esize / 2));
-	ElemP_set(zx, &result, e, esize, p);
-    }
+    Perm op = ((part == 0) ? Perm_TRN1 : Perm_TRN2);
+    preg result = permute_preg(zx, op, esize, &zx->p[Pn], &zx->p[Pm]);
     zx->p[Pd] = result;
 }
 
-/* Extracts half-sized elements (high-half/low-half) to a full-sized
-   elements. */
+static void
+perform_TRN_z(svecxt_t *zx, int esize, int part, int Zn, int Zm, int Zd)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    Perm op = ((part == 0) ? Perm_TRN1 : Perm_TRN2);
+    zreg result = permute_zreg(zx, op, esize, &zx->z[Zn], &zx->z[Zm]);
+    zx->z[Zd] = result;
+}
+
+/* COMPACT packs the active elements of a 128-bit segment by a
+   shuffle looked up by the predicate bits of the segment (a nibble
+   for 32-bit elements, two bits for 64-bit ones).  Unused positions
+   of a shuffle (0xff) give zeros. */
+
+static const u8 compact_shuffle32[16][16] = {
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {4, 5, 6, 7, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 4, 5, 6, 7,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {8, 9, 10, 11, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 8, 9, 10, 11,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {4, 5, 6, 7, 8, 9, 10, 11,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 4, 5, 6, 7,
+     8, 9, 10, 11, 0xff, 0xff, 0xff, 0xff},
+    {12, 13, 14, 15, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 12, 13, 14, 15,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {4, 5, 6, 7, 12, 13, 14, 15,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 4, 5, 6, 7,
+     12, 13, 14, 15, 0xff, 0xff, 0xff, 0xff},
+    {8, 9, 10, 11, 12, 13, 14, 15,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 8, 9, 10, 11,
+     12, 13, 14, 15, 0xff, 0xff, 0xff, 0xff},
+    {4, 5, 6, 7, 8, 9, 10, 11,
+     12, 13, 14, 15, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 4, 5, 6, 7,
+     8, 9, 10, 11, 12, 13, 14, 15}};
+
+static const u8 compact_shuffle64[4][16] = {
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 4, 5, 6, 7,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {8, 9, 10, 11, 12, 13, 14, 15,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0, 1, 2, 3, 4, 5, 6, 7,
+     8, 9, 10, 11, 12, 13, 14, 15}};
 
 static void
-perform_UNPACK_z(svecxt_t *zx, int esize, int hi, bool unsignedp,
-		 int Zn, int Zd)
+perform_COMPACT_z(svecxt_t *zx, int esize, int Zd, int Pg, int Zn)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
-    int hsize = esize / 2;
-    zreg operand = zx->z[Zn];
+    assert(esize == 32 || esize == 64);
+    int ebytes = esize / 8;
+    int lanes = 16 / ebytes;
+    preg *mask = &zx->p[Pg];
+    zreg *operand1 = &zx->z[Zn];
     zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 element;
-	if (hi) {
-	    element = Elem_get(zx, &operand, (e + elements), hsize, unsignedp);
-	} else{
-	    element = Elem_get(zx, &operand, e, hsize, unsignedp);
+    int x = 0;
+    /*NEON*/
+    for (int i = 0; i < (zx->VL / 8); i += 16) {
+	int bits = 0;
+	for (int l = 0; l < lanes; l++) {
+	    bits |= ((mask->k[i + l * ebytes] ? 1 : 0) << l);
 	}
-	Elem_set(zx, &result, e, esize, element);
+	const u8 *shuffle = ((esize == 32)
+			     ? compact_shuffle32[bits]
+			     : compact_shuffle64[bits]);
+	uint8x16_t v = vqtbl1q_u8(vld1q_u8(&operand1->b[i]),
+				  vld1q_u8(shuffle));
+	/* The store may spill zeros past the packed elements, which
+	   are overwritten by the next segment or are left as zeros. */
+	vst1q_u8(&result.b[x], v);
+	x += (__builtin_popcount((unsigned)bits) * ebytes);
     }
     zx->z[Zd] = result;
 }
 
+/* SPLICE copies the elements of Zdn from the first to the last
+   active ones, and fills the rest by the leading elements of Zm. */
+
 static void
-perform_PTRUE_p(svecxt_t *zx, int esize, int Pd, int pat, bool setflags)
+perform_SPLICE_z(svecxt_t *zx, int esize, int Zdn, int Pg, int Zm)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
-    int count = DecodePredCount(zx, pat, esize);
-    preg result = preg_zeros;
-    for (int e = 0; e < elements; e++) {
-	ElemP_set(zx, &result, e, esize, (e < count));
-    }
-    if (setflags) {
-	NZCV_set(zx, PredTest(zx, &result, &result, esize));
+    int ebytes = esize / 8;
+    size_t vlen = (size_t)(zx->VL / 8);
+    preg *mask = &zx->p[Pg];
+    int first = preg_scan_first(zx, mask, mask, esize, 0);
+    int last = preg_scan_last(zx, mask, mask, esize);
+    size_t len = ((first >= 0) ? (size_t)((last - first + 1) * ebytes) : 0);
+    zreg result = zreg_zeros;
+    if (len != 0) {
+	memcpy(&result.b[0], &zx->z[Zdn].b[first * ebytes], len);
     }
-    zx->p[Pd] = result;
+    memcpy(&result.b[len], &zx->z[Zm].b[0], (vlen - len));
+    zx->z[Zdn] = result;
 }
 
-/* Scans a predicate vector with and-not.  BEFORE means
-   inclusive-scan.  When merging, masked entries are unmodified.  When
-   the register number Pm!=99, scan continues from the last value in
-   P[Pm].  Note the pseudo-codes for BRK[A,B][-,S] and BRKP[A,B][-,S]
-   use the different flags whose polarity is inverted (BREAK and
-   LAST).  This code uses LAST. */
+/* EXT shifts Zdn down by POSITION bytes in place, and fills the top
+   by the low bytes of Zm.  When Zm is Zdn, it is a rotation. */
 
 static void
-perform_BREAK_p(svecxt_t *zx, int esize, bool merging, bool setflags,
-		int break_before0_after1,
-		int Pd, int Pmn, int Pprevious, int Pg)
+perform_EXT_z(svecxt_t *zx, int Zdn, int Zm, int position)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    bool propagating = (Pprevious != 99);
-    assert(break_before0_after1 == 0 || break_before0_after1 == 1);
-    assert(!propagating || (!merging && esize == 8 && Pprevious != 99));
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    preg operand_last = (propagating ? zx->p[Pprevious] : preg_zeros);
-    preg operand = zx->p[Pmn];
-    preg operand_merge = zx->p[Pd];
-    bool last;
-    if (propagating) {
-	assert(!merging && esize == 8 && Pprevious != 99);
-	last = (LastActive(zx, &mask, &operand_last, 8) == 1);
-    } else {
-	last = true;
-    }
-    preg result = preg_zeros;
-    for (int e = 0; e < elements; e++) {
-	bool element = (ElemP_get(zx, &operand, e, esize) == 1);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    if (break_before0_after1 == 0) {
-		last = last && !element;
-	    }
-	    ElemP_set(zx, &result, e, esize, (last ? true : false));
-	    if (break_before0_after1 == 1) {
-		last = last && !element;
-	    }
-	} else if (merging) {
-	    bool p = ElemP_get(zx, &operand_merge, e, esize);
-	    ElemP_set(zx, &result, e, esize, p);
-	} else {
-	    ElemP_set(zx, &result, e, esize, false);
-	}
+    size_t vlen = (size_t)(zx->VL / 8);
+    size_t pos = ((position >= (int)vlen) ? 0 : (size_t)position);
+    u8 *d = zx->z[Zdn].b;
+    const u8 *s = zx->z[Zm].b;
+    u8 head[256];
+    if (Zm == Zdn) {
+	memcpy(head, d, pos);
+	s = head;
     }
+    memmove(&d[0], &d[pos], (vlen - pos));
+    memcpy(&d[vlen - pos], s, pos);
+}
+
+/* INSR shifts Zdn up by an element in place, and inserts a scalar at
+   element 0. */
+
+static void
+perform_INSR_z(svecxt_t *zx, int esize, int Zdn, u64 v)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    size_t ebytes = (size_t)(esize / 8);
+    size_t vlen = (size_t)(zx->VL / 8);
+    u8 *d = zx->z[Zdn].b;
+    memmove(&d[ebytes], &d[0], (vlen - ebytes));
+    memcpy(&d[0], &v, ebytes);
+}
+
+/* Looks up elements by the indices in Zm.  The byte indices are made
+   per element at run time, and out-of-range elements are zeroed. */
+
+static void
+perform_TBL_z(svecxt_t *zx, int esize, int Zd, int Zn, int Zm)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int elements = zx->VL / esize;
+    int ebytes = esize / 8;
+    zreg *operand2 = &zx->z[Zm];
+    u16 index[256];
+    for (int e = 0; e < elements; e++) {
+	u64 idx = (u64)Elem_get(zx, operand2, e, esize, U64EXT);
+	for (int j = 0; j < ebytes; j++) {
+	    index[e * ebytes + j] = ((idx < (u64)elements)
+				     ? (u16)((int)idx * ebytes + j)
+				     : PERMUTE_ZERO);
+	}
+    }
+    zreg result = zreg_zeros;
+    permute_bytes(zx, index, zx->z[Zn].b, 0, result.b);
+    zx->z[Zd] = result;
+}
+
+/* Unpacks a half of a predicate.  A predicate has a byte for a bit,
+   and doubling the element size of the bits is zero-extending the
+   bytes, which is done by vmovl. */
+
+static void
+perform_UNPACK_p(svecxt_t *zx, int esize, int hi,
+		 int Pn, int Pd)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(esize == 16);
+    int bytes = zx->PL;
+    preg operand = zx->p[Pn];
+    preg result = preg_zeros;
+    u8 *src = (u8 *)&operand.k[hi ? (bytes / 2) : 0];
+    /*NEON*/
+    for (int i = 0; i < bytes; i += 16) {
+	uint16x8_t v = vmovl_u8(vld1_u8(&src[i / 2]));
+	vst1q_u8((u8 *)&result.k[i], vreinterpretq_u8_u16(v));
+    }
+    zx->p[Pd] = result;
+}
+
+/* Extracts half-sized elements (high-half/low-half) to a full-sized
+   elements.  A 128-bit segment is made from 64 bits of the source by
+   vmovl. */
+
+static void
+perform_UNPACK_z(svecxt_t *zx, int esize, int hi, bool unsignedp,
+		 int Zn, int Zd)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    zreg operand = zx->z[Zn];
+    zreg result = zreg_zeros;
+    u8 *src = &operand.b[hi ? (zx->VL / 16) : 0];
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	uint8x8_t x = vld1_u8(&src[8 * i]);
+	uint8x16_t v;
+	switch (esize) {
+	case 16:
+	    v = (unsignedp
+		 ? vreinterpretq_u8_u16(vmovl_u8(x))
+		 : vreinterpretq_u8_s16(vmovl_s8(vreinterpret_s8_u8(x))));
+	    break;
+	case 32:
+	    v = (unsignedp
+		 ? vreinterpretq_u8_u32(vmovl_u16(vreinterpret_u16_u8(x)))
+		 : vreinterpretq_u8_s32(vmovl_s16(vreinterpret_s16_u8(x))));
+	    break;
+	case 64:
+	    v = (unsignedp
+		 ? vreinterpretq_u8_u64(vmovl_u32(vreinterpret_u32_u8(x)))
+		 : vreinterpretq_u8_s64(vmovl_s32(vreinterpret_s32_u8(x))));
+	    break;
+	default:
+	    assert(esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+	vst1q_u8(&result.b[16 * i], v);
+    }
+    zx->z[Zd] = result;
+}
+
+/* Returns a predicate with the first COUNT elements active. */
+
+static preg
+preg_prefix(svecxt_t *zx, int esize, int count)
+{
+    assert(count >= 0 && count <= (zx->VL / esize));
+    int psize = esize / 8;
+    int bytes = count * psize;
+    preg p = preg_zeros;
+    /*NEON*/
+    uint8x16_t ones = ElemP_ones(esize);
+    int i;
+    for (i = 0; (i + 16) <= bytes; i += 16) {
+	vst1q_u8((u8 *)&p.k[i], ones);
+    }
+    for (; i < bytes; i += psize) {
+	p.k[i] = 1;
+    }
+    return p;
+}
+
+static void
+perform_PTRUE_p(svecxt_t *zx, int esize, int Pd, int pat, bool setflags)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int count = DecodePredCount(zx, pat, esize);
+    preg result = preg_prefix(zx, esize, count);
     if (setflags) {
-	NZCV_set(zx, PredTest(zx, &mask, &result, esize));
+	/* PredTest(result, result) */
+	bool4 nzcv = {(count > 0), (count == 0), (count == 0), 0};
+	NZCV_set(zx, nzcv);
     }
     zx->p[Pd] = result;
 }
 
+/* Scans a predicate vector with and-not.  BEFORE means
+   inclusive-scan.  When merging, masked entries are unmodified.  When
+   the register number Pm!=99, scan continues from the last value in
+   P[Pm].  Note the pseudo-codes for BRK[A,B][-,S] and BRKP[A,B][-,S]
+   use the different flags whose polarity is inverted (BREAK and
+   LAST).  This code uses LAST.  The active elements of the result
+   are a prefix up to the first active true element of the operand,
+   and it is merged by a bitwise select on the mask. */
+
 static void
-perform_BREAK_NEXT_p(svecxt_t *zx, int esize, bool setflags,
-		     int Pd, int Pn, int Pg)
+perform_BREAK_p(svecxt_t *zx, int esize, bool merging, bool setflags,
+		int break_before0_after1,
+		int Pd, int Pmn, int Pprevious, int Pg)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
+    bool propagating = (Pprevious != 99);
+    assert(break_before0_after1 == 0 || break_before0_after1 == 1);
+    assert(!propagating || (!merging && esize == 8 && Pprevious != 99));
     assert(esize == 8);
+    int elements = zx->VL / esize;
     preg mask = zx->p[Pg];
-    preg operand1 = zx->p[Pn];
-    preg operand2 = zx->p[Pd];
-    preg result = preg_zeros;
-    if (LastActive(zx, &mask, &operand1, 8) == 1) {
-	result = operand2;
+    preg operand = zx->p[Pmn];
+    preg operand_merge = (merging ? zx->p[Pd] : preg_zeros);
+    bool last;
+    if (propagating) {
+	last = (LastActive(zx, &mask, &zx->p[Pprevious], 8) == 1);
+    } else {
+	last = true;
+    }
+    int count;
+    if (!last) {
+	count = 0;
     } else {
-	result = preg_zeros;
+	int brk = preg_scan_first(zx, &mask, &operand, esize, 0);
+	count = ((brk == -1) ? elements : (brk + break_before0_after1));
+    }
+    preg prefix = preg_prefix(zx, esize, count);
+    preg result = preg_zeros;
+    /*NEON*/
+    for (int i = 0; i < zx->PL; i += 16) {
+	uint8x16_t m = vld1q_u8((u8 *)&mask.k[i]);
+	uint8x16_t sel = vtstq_u8(m, vdupq_n_u8(0xffU));
+	uint8x16_t r = vbslq_u8(sel, vld1q_u8((u8 *)&prefix.k[i]),
+				vld1q_u8((u8 *)&operand_merge.k[i]));
+	vst1q_u8((u8 *)&result.k[i], r);
     }
     if (setflags) {
-	preg ones = preg_all_ones;
-	NZCV_set(zx, PredTest(zx, &ones, &result, 8));
+	/* PredTest(mask, result) */
+	int first = preg_scan_first(zx, &mask, &mask, esize, 0);
+	int lastactive = preg_scan_last(zx, &mask, &mask, esize);
+	bool n = (first != -1 && first < count);
+	bool c = !(lastactive != -1 && lastactive < count);
+	bool4 nzcv = {n, !n, c, 0};
+	NZCV_set(zx, nzcv);
     }
     zx->p[Pd] = result;
 }
 
+static void
+perform_BREAK_NEXT_p(svecxt_t *zx, int esize, bool setflags,
+		     int Pd, int Pn, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(esize == 8);
+    int elements = zx->VL / esize;
+    bool last = (LastActive(zx, &zx->p[Pg], &zx->p[Pn], 8) == 1);
+    if (!last) {
+	zx->p[Pd] = preg_zeros;
+    }
+    if (setflags) {
+	/* PredTest(ones, result) */
+	preg *result = &zx->p[Pd];
+	int first = preg_scan_first(zx, result, result, esize, 0);
+	bool n = (first == 0);
+	bool z = (first == -1);
+	bool c = (ElemP_get(zx, result, (elements - 1), esize) == 0);
+	bool4 nzcv = {n, z, c, 0};
+	NZCV_set(zx, nzcv);
+    }
+}
+
 /* Extracts a last active element.  When CONDITIONAL, it keeps the old
    value if there are no active elements.  MEMO: csize/rsize is
    unused (it is 32 or 64 for X-registers). */
 
+static int
+last_position(svecxt_t *zx, int esize, bool isBefore, int last)
+{
+    int elements = zx->VL / esize;
+    if (last < 0) {
+	return (isBefore ? (elements - 1) : 0);
+    } else if (!isBefore) {
+	return (((last + 1) >= elements) ? 0 : (last + 1));
+    } else {
+	return last;
+    }
+}
+
 static void
 perform_LAST_xv(svecxt_t *zx, int esize, bool conditional,
 		bool isBefore, enum xvregset X0V1, int Rdn, int Zm, int Pg)
@@ -2414,33 +3276,20 @@ perform_LAST_xv(svecxt_t *zx, int esize, bool conditional,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    u64 opr = (X0V1 == XREG) ? Xreg_get(zx, Rdn, X31ZERO) : Vreg_get(zx, Rdn);
-    u64 operand1 = sign_extend(opr, esize, U64EXT);
-    zreg operand2 = zx->z[Zm];
-    u64 result;
-    int last = LastActiveElement(zx, &mask, esize);
-    if (last < 0) {
-	if (conditional) {
-	    result = operand1;
+    int last = LastActiveElement(zx, &zx->p[Pg], esize);
+    if (last < 0 && conditional) {
+	u64 opr = ((X0V1 == XREG)
+		   ? Xreg_get(zx, Rdn, X31ZERO) : Vreg_get(zx, Rdn));
+	u64 operand1 = sign_extend(opr, esize, U64EXT);
+	if (X0V1 == XREG) {
+	    Xreg_set(zx, Rdn, operand1);
 	} else {
-	    if (isBefore) {
-		last = elements - 1;
-	    } else {
-		last = 0;
-	    }
-	    result = Elem_get(zx, &operand2, last, esize, U64EXT);
+	    Vreg_set(zx, Rdn, operand1);
 	}
-    } else {
-	if (!isBefore) {
-	    last = last + 1;
-	    if (last >= elements) {
-		last = 0;
-	    }
-	}
-	result = Elem_get(zx, &operand2, last, esize, U64EXT);
+	return;
     }
+    int position = last_position(zx, esize, isBefore, last);
+    u64 result = Elem_get(zx, &zx->z[Zm], position, esize, U64EXT);
     if (X0V1 == XREG) {
 	Xreg_set(zx, Rdn, result);
     } else {
@@ -2458,27 +3307,13 @@ perform_LAST_z(svecxt_t *zx, int esize, bool isBefore,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg operand1 = zx->z[Zd];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    int last = LastActiveElement(zx, &mask, esize);
+    int last = LastActiveElement(zx, &zx->p[Pg], esize);
     if (last < 0) {
-	result = operand1;
-    } else {
-	if (!isBefore) {
-	    last = last + 1;
-	    if (last >= elements) {
-		last = 0;
-	    }
-	}
-	u64 v = Elem_get(zx, &operand2, last, esize, DONTCARE);
-	for (int e = 0; e < elements; e++) {
-	    Elem_set(zx, &result, e, esize, v);
-	}
+	return;
     }
-    zx->z[Zd] = result;
+    int position = last_position(zx, esize, isBefore, last);
+    u64 v = Elem_get(zx, &zx->z[Zm], position, esize, DONTCARE);
+    zx->z[Zd] = Replicate_z(zx, esize, v);
 }
 
 /* Gets the element count for the element size.  The count is
@@ -2529,39 +3364,11 @@ perform_TERM_x(svecxt_t *zx, int esize, SVECmp op, int Rn, int Rm)
     }
 }
 
-static bool
-compare_i64(SVECmp op, bool signedp, u64 x, u64 y)
-{
-    if (signedp == S64EXT) {
-	switch (op) {
-	case Cmp_EQ: return ((s64)x == (s64)y);
-	case Cmp_NE: return ((s64)x != (s64)y);
-	case Cmp_GE: return ((s64)x >= (s64)y);
-	case Cmp_LT: return ((s64)x < (s64)y);
-	case Cmp_GT: return ((s64)x > (s64)y);
-	case Cmp_LE: return ((s64)x <= (s64)y);
-	default:
-	    assert(op == Cmp_EQ || op == Cmp_NE
-		   || op == Cmp_GE || op == Cmp_LT
-		   || op == Cmp_GT || op == Cmp_LE);
-	    abort();
-	}
-    } else {
-	switch (op) {
-	case Cmp_EQ: return ((u64)x == (u64)y);
-	case Cmp_NE: return ((u64)x != (u64)y);
-	case Cmp_GE: return ((u64)x >= (u64)y);
-	case Cmp_LT: return ((u64)x < (u64)y);
-	case Cmp_GT: return ((u64)x > (u64)y);
-	case Cmp_LE: return ((u64)x <= (u64)y);
-	default:
-	    assert(op == Cmp_EQ || op == Cmp_NE
-		   || op == Cmp_GE || op == Cmp_LT
-		   || op == Cmp_GT || op == Cmp_LE);
-	    abort();
-	}
-    }
-}
+/* WHILE is computed in the closed form.  The predicate has a prefix
+   of active elements, whose count is the distance from operand1 to
+   operand2 (plus one for LE).  Operand1 never wraps around while the
+   condition holds for LT.  For LE, when operand2 is the largest
+   value, operand1 wraps around and all elements are active. */
 
 static inline void
 perform_WHILE_p(svecxt_t *zx, int esize, int rsize,
@@ -2571,28 +3378,140 @@ perform_WHILE_p(svecxt_t *zx, int esize, int rsize,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    assert(cmp == Cmp_GE || cmp == Cmp_LT || cmp == Cmp_GT || cmp == Cmp_LE);
+    assert(cmp == Cmp_LT || cmp == Cmp_LE);
+    assert(rsize == 32 || rsize == 64);
     int elements = zx->VL / esize;
-    preg mask = preg_all_ones;
     u64 operand1 = sign_extend(Xreg_get(zx, Rn, X31ZERO), rsize, unsignedp);
     u64 operand2 = sign_extend(Xreg_get(zx, Rm, X31ZERO), rsize, unsignedp);
-    preg result = preg_zeros;
-    bool last;
-    last = true;
-    for (int e = 0; e < elements; e++) {
-	bool cond = compare_i64(cmp, unsignedp, operand1, operand2);
-	last = last && cond;
-	ElemP_set(zx, &result, e, esize, (last ? 1 : 0));
-	if (cmp == Cmp_GE || cmp == Cmp_GT) {
-	    operand1 = operand1 - 1;
+    bool cond;
+    u64 largest;
+    if (unsignedp) {
+	cond = ((cmp == Cmp_LT)
+		? (operand1 < operand2) : (operand1 <= operand2));
+	largest = ((rsize == 64) ? ~0ULL : 0xffffffffULL);
+    } else {
+	cond = ((cmp == Cmp_LT)
+		? ((s64)operand1 < (s64)operand2)
+		: ((s64)operand1 <= (s64)operand2));
+	largest = ((rsize == 64) ? 0x7fffffffffffffffULL : 0x7fffffffULL);
+    }
+    int count;
+    if (!cond) {
+	count = 0;
+    } else {
+	u64 distance = (operand2 - operand1);
+	if (cmp == Cmp_LE && operand2 == largest) {
+	    count = elements;
+	} else if (cmp == Cmp_LE) {
+	    count = ((distance < (u64)elements) ? (int)distance + 1 : elements);
 	} else {
-	    operand1 = operand1 + 1;
+	    count = ((distance < (u64)elements) ? (int)distance : elements);
 	}
     }
-    NZCV_set(zx, PredTest(zx, &mask, &result, esize));
+    preg result = preg_prefix(zx, esize, count);
+    bool4 nzcv = {(count > 0), (count == 0), (count != elements), 0};
+    NZCV_set(zx, nzcv);
     zx->p[Pd] = result;
 }
 
+/* NEON KERNELS of integer compares.  A kernel returns the lane masks
+   of a 128-bit segment.  LT/LE are GT/GE with swapped operands, and
+   NE is the negation of EQ. */
+
+static uint8x16_t
+icmp_kernel(int esize, SVECmp op, bool unsignedp, uint8x16_t x, uint8x16_t y)
+{
+    bool swapp = (op == Cmp_LT || op == Cmp_LE);
+    bool eqp = (op == Cmp_EQ || op == Cmp_NE);
+    bool gtp = (op == Cmp_GT || op == Cmp_LT);
+    uint8x16_t a = (swapp ? y : x);
+    uint8x16_t b = (swapp ? x : y);
+    uint8x16_t m;
+    /*NEON*/
+    switch (esize) {
+    case 8: {
+	int8x16_t sa = vreinterpretq_s8_u8(a);
+	int8x16_t sb = vreinterpretq_s8_u8(b);
+	if (eqp) {
+	    m = vceqq_u8(a, b);
+	} else if (unsignedp) {
+	    m = (gtp ? vcgtq_u8(a, b) : vcgeq_u8(a, b));
+	} else {
+	    m = (gtp ? vcgtq_s8(sa, sb) : vcgeq_s8(sa, sb));
+	}
+	break;
+    }
+    case 16: {
+	uint16x8_t ua = vreinterpretq_u16_u8(a);
+	uint16x8_t ub = vreinterpretq_u16_u8(b);
+	int16x8_t sa = vreinterpretq_s16_u8(a);
+	int16x8_t sb = vreinterpretq_s16_u8(b);
+	uint16x8_t v;
+	if (eqp) {
+	    v = vceqq_u16(ua, ub);
+	} else if (unsignedp) {
+	    v = (gtp ? vcgtq_u16(ua, ub) : vcgeq_u16(ua, ub));
+	} else {
+	    v = (gtp ? vcgtq_s16(sa, sb) : vcgeq_s16(sa, sb));
+	}
+	m = vreinterpretq_u8_u16(v);
+	break;
+    }
+    case 32: {
+	uint32x4_t ua = vreinterpretq_u32_u8(a);
+	uint32x4_t ub = vreinterpretq_u32_u8(b);
+	int32x4_t sa = vreinterpretq_s32_u8(a);
+	int32x4_t sb = vreinterpretq_s32_u8(b);
+	uint32x4_t v;
+	if (eqp) {
+	    v = vceqq_u32(ua, ub);
+	} else if (unsignedp) {
+	    v = (gtp ? vcgtq_u32(ua, ub) : vcgeq_u32(ua, ub));
+	} else {
+	    v = (gtp ? vcgtq_s32(sa, sb) : vcgeq_s32(sa, sb));
+	}
+	m = vreinterpretq_u8_u32(v);
+	break;
+    }
+    case 64: {
+	uint64x2_t ua = vreinterpretq_u64_u8(a);
+	uint64x2_t ub = vreinterpretq_u64_u8(b);
+	int64x2_t sa = vreinterpretq_s64_u8(a);
+	int64x2_t sb = vreinterpretq_s64_u8(b);
+	uint64x2_t v;
+	if (eqp) {
+	    v = vceqq_u64(ua, ub);
+	} else if (unsignedp) {
+	    v = (gtp ? vcgtq_u64(ua, ub) : vcgeq_u64(ua, ub));
+	} else {
+	    v = (gtp ? vcgtq_s64(sa, sb) : vcgeq_s64(sa, sb));
+	}
+	m = vreinterpretq_u8_u64(v);
+	break;
+    }
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+    return ((op == Cmp_NE) ? vmvnq_u8(m) : m);
+}
+
+/* Narrows the lane masks M of the I-th 128-bit segment to the
+   predicate bytes of the result, under the governing MASK.  It
+   accumulates the flags in T. */
+
+static void
+icmp_segment(svecxt_t *zx, int esize, preg *mask, int i, uint8x16_t m,
+	     preg *result, predtest_t *t)
+{
+    /*NEON*/
+    uint8x16_t g = vandq_u8(ElemP_lanes(zx, mask, (i * 128 / esize), esize),
+			    ElemP_ones(esize));
+    uint8x16_t r = vandq_u8(m, g);
+    vst1q_u8((u8 *)&result->k[16 * i], r);
+    PredTest_segment(t, (16 * i), g, r);
+}
+
 static void
 perform_ICMP_z_z_imm(svecxt_t *zx, int esize, SVECmp op, bool unsignedp,
 		     bool z0imm1, int Pd, int Zn, int Zm, s64 imm, int Pg)
@@ -2607,27 +3526,23 @@ perform_ICMP_z_z_imm(svecxt_t *zx, int esize, SVECmp op, bool unsignedp,
 	   || op == Cmp_GE || op == Cmp_LT
 	   || op == Cmp_GT || op == Cmp_LE);
 
-    int elements = zx->VL / esize;
+    /* The immediates fit in the element size. */
+
+    int segments = zx->VL / 128;
     preg mask = zx->p[Pg];
     zreg operand1 = zx->z[Zn];
-    zreg operand2 = ((z0imm1 == false) ? zx->z[Zm] : zreg_zeros);
+    zreg operand2 = ((z0imm1 == false)
+		     ? zx->z[Zm] : Replicate_z(zx, esize, (u64)imm));
     preg result = preg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 element1 = Elem_get(zx, &operand1, e, esize, unsignedp);
-	u64 element2;
-	if (z0imm1 == false) {
-	    element2 = Elem_get(zx, &operand2, e, esize, unsignedp);
-	} else {
-	    element2 = (u64)imm;
-	}
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    bool cond = compare_i64(op, unsignedp, element1, element2);
-	    ElemP_set(zx, &result, e, esize, cond);
-	} else {
-	    ElemP_set(zx, &result, e, esize, 0);
-	}
-    }
-    NZCV_set(zx, PredTest(zx, &mask, &result, esize));
+    predtest_t t = predtest_initial;
+    for (int i = 0; i < segments; i++) {
+	/*NEON*/
+	uint8x16_t x = vld1q_u8(&operand1.b[16 * i]);
+	uint8x16_t y = vld1q_u8(&operand2.b[16 * i]);
+	uint8x16_t m = icmp_kernel(esize, op, unsignedp, x, y);
+	icmp_segment(zx, esize, &mask, i, m, &result, &t);
+    }
+    NZCV_set(zx, PredTest_result(&t));
     zx->p[Pd] = result;
 }
 
@@ -2647,6 +3562,35 @@ perform_ICMP_z_imm(svecxt_t *zx, int esize, SVECmp op, bool unsignedp,
 			 true, Pd, Zn, 99, imm, Pg);
 }
 
+/* Checks a 64-bit second operand of the wide compares against the
+   range of the element size.  It returns -1 when it is in the range
+   and the compare is done in the element size, or returns the
+   constant result otherwise. */
+
+static int
+icmp_wide_range(int esize, SVECmp op, bool unsignedp, u64 y)
+{
+    bool above;
+    bool below;
+    if (esize == 64) {
+	above = false;
+	below = false;
+    } else if (unsignedp) {
+	above = (y > ((1ULL << esize) - 1));
+	below = false;
+    } else {
+	above = ((s64)y > (s64)((1ULL << (esize - 1)) - 1));
+	below = ((s64)y < -(s64)(1ULL << (esize - 1)));
+    }
+    if (above) {
+	return (op == Cmp_LT || op == Cmp_LE || op == Cmp_NE);
+    } else if (below) {
+	return (op == Cmp_GT || op == Cmp_GE || op == Cmp_NE);
+    } else {
+	return -1;
+    }
+}
+
 static void
 perform_ICMP_z_z_wide2nd(svecxt_t *zx, int esize, SVECmp op, bool unsignedp,
 			 int Pd, int Zn, int Zm, int Pg)
@@ -2659,28 +3603,41 @@ perform_ICMP_z_z_wide2nd(svecxt_t *zx, int esize, SVECmp op, bool unsignedp,
 	   || op == Cmp_GE || op == Cmp_LT
 	   || op == Cmp_GT || op == Cmp_LE);
 
-    int elements = zx->VL / esize;
+    int segments = zx->VL / 128;
     preg mask = zx->p[Pg];
     zreg operand1 = zx->z[Zn];
     zreg operand2 = zx->z[Zm];
     preg result = preg_zeros;
-    for (int e = 0; e < elements; e++) {
-	int e2 = ((e * esize) / 64);
-	u64 element1 = Elem_get(zx, &operand1, e, esize, unsignedp);
-	u64 element2 = Elem_get(zx, &operand2, e2, 64, unsignedp);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    bool cond = compare_i64(op, unsignedp, element1, element2);
-	    ElemP_set(zx, &result, e, esize, cond);
-	} else {
-	    ElemP_set(zx, &result, e, esize, 0);
+    predtest_t t = predtest_initial;
+    u64 emask = ((esize == 64) ? ~0ULL : ((1ULL << esize) - 1));
+    for (int i = 0; i < segments; i++) {
+	u64 y0 = operand2.x[2 * i];
+	u64 y1 = operand2.x[2 * i + 1];
+	int c0 = icmp_wide_range(esize, op, unsignedp, y0);
+	int c1 = icmp_wide_range(esize, op, unsignedp, y1);
+	/*NEON*/
+	uint8x16_t x = vld1q_u8(&operand1.b[16 * i]);
+	uint64x2_t y2 = vcombine_u64(vcreate_u64(Replicate(64, esize, (y0 & emask))),
+				     vcreate_u64(Replicate(64, esize, (y1 & emask))));
+	uint8x16_t m = icmp_kernel(esize, op, unsignedp, x,
+				   vreinterpretq_u8_u64(y2));
+	uint64x2_t m2 = vreinterpretq_u64_u8(m);
+	if (c0 != -1) {
+	    m2 = vsetq_lane_u64((c0 ? ~0ULL : 0ULL), m2, 0);
 	}
+	if (c1 != -1) {
+	    m2 = vsetq_lane_u64((c1 ? ~0ULL : 0ULL), m2, 1);
+	}
+	icmp_segment(zx, esize, &mask, i, vreinterpretq_u8_u64(m2),
+		     &result, &t);
     }
-    NZCV_set(zx, PredTest(zx, &mask, &result, esize));
+    NZCV_set(zx, PredTest_result(&t));
     zx->p[Pd] = result;
 }
 
 /* The unary operations (NEG/NOT/ZEROP/ABS) work on the Y operand,
-   ignoring the X.  The all are predicated. */
+   ignoring the X.  The all are predicated.  Shifts are in
+   shift_kernel(). */
 
 static u64
 calculate_iop(int esize, Iop op, u64 x, u64 y)
@@ -2716,19 +3673,6 @@ calculate_iop(int esize, Iop op, u64 x, u64 y)
     case Iop_CLZ: v = (u64)(u32)CountLeadingZeroBits(esize, y); break;
     case Iop_CLS: v = (u64)(u32)CountLeadingSignBits(esize, y); break;
 
-    case Iop_ASH_R: v = (u64)((s64)x >> y); break;
-    case Iop_ASH_R_REV: v = (u64)((s64)y >> x); break;
-    case Iop_ASH_DIV: {
-	/* Offset for rounding toward zero. */
-	u64 x1 = (((s64)x >= 0) ? x : (x + (u64)((1 << y) - 1)));
-	v = (u64)((s64)x1 >> y);
-	break;
-    }
-    case Iop_LSH_L: v = (u64)((u64)x << y); break;
-    case Iop_LSH_L_REV: v = (u64)((u64)y << x); break;
-    case Iop_LSH_R: v = (u64)((u64)x >> y); break;
-    case Iop_LSH_R_REV: v = (u64)((u64)y >> x); break;
-
     default:
 	assert(op == Iop_AND || op == Iop_IOR || op == Iop_XOR
 	       || op == Iop_ANDN
@@ -2741,10 +3685,7 @@ calculate_iop(int esize, Iop op, u64 x, u64 y)
 	       || op == Iop_SDIFF || op == Iop_UDIFF
 	       || op == Iop_NEG || op == Iop_NOT
 	       || op == Iop_ZEROP || op == Iop_ABS
-	       || op == Iop_BITREVERSE
-	       || op == Iop_ASH_R || op == Iop_ASH_DIV
-	       || op == Iop_LSH_L || op == Iop_LSH_L_REV
-	       || op == Iop_LSH_R || op == Iop_LSH_R_REV);
+	       || op == Iop_BITREVERSE);
 	abort();
     }
     return v;
@@ -2791,15 +3732,116 @@ sqrt_sf(float x)
     return z;
 }
 
-/* MEMO: C99 fmax()/fmin() ignores a nan (on a single side). */
+/* Rounds to an integral value by FRINTx.  FRINTI and FRINTX use the
+   rounding mode in the FPCR. */
 
 static double
-max_df(double x, double y)
+rint_df(Fop op, double x)
 {
-    if (isnan(x) || isnan(y)) {
-	return nan("");
-    } else {
-	return ((x >= y) ? x : y);
+    /*NEON*/
+    float64x1_t v0 = vdup_n_f64(x);
+    float64x1_t v1;
+    switch (op) {
+    case Fop_RINTA: v1 = vrnda_f64(v0); break;
+    case Fop_RINTI: v1 = vrndi_f64(v0); break;
+    case Fop_RINTM: v1 = vrndm_f64(v0); break;
+    case Fop_RINTN: v1 = vrndn_f64(v0); break;
+    case Fop_RINTP: v1 = vrndp_f64(v0); break;
+    case Fop_RINTX: v1 = vrndx_f64(v0); break;
+    case Fop_RINTZ: v1 = vrnd_f64(v0); break;
+    default:
+	assert(op == Fop_RINTA);
+	abort();
+    }
+    double z = vget_lane_f64(v1, 0);
+    return z;
+}
+
+static float
+rint_sf(Fop op, float x)
+{
+    /*NEON*/
+    float32x2_t v0 = vdup_n_f32(x);
+    float32x2_t v1;
+    switch (op) {
+    case Fop_RINTA: v1 = vrnda_f32(v0); break;
+    case Fop_RINTI: v1 = vrndi_f32(v0); break;
+    case Fop_RINTM: v1 = vrndm_f32(v0); break;
+    case Fop_RINTN: v1 = vrndn_f32(v0); break;
+    case Fop_RINTP: v1 = vrndp_f32(v0); break;
+    case Fop_RINTX: v1 = vrndx_f32(v0); break;
+    case Fop_RINTZ: v1 = vrnd_f32(v0); break;
+    default:
+	assert(op == Fop_RINTA);
+	abort();
+    }
+    float z = vget_lane_f32(v1, 0);
+    return z;
+}
+
+/* FRECPX on lanes, since NEON has it only for scalars.  It is the
+   sign and the inverted exponent with a zero fraction.  A zero
+   exponent gives the largest normal exponent.  NaNs are processed by
+   adding them to themselves. */
+
+static float32x4_t
+recpx_sf4(float32x4_t x)
+{
+    /*NEON*/
+    uint32x4_t v = vreinterpretq_u32_f32(x);
+    uint32x4_t expmask = vdupq_n_u32(0x7f800000U);
+    uint32x4_t e0 = vandq_u32(v, expmask);
+    uint32x4_t e1 = vbslq_u32(vceqq_u32(e0, vdupq_n_u32(0)),
+			      vdupq_n_u32(0x7f000000U),
+			      vbicq_u32(expmask, v));
+    uint32x4_t r = vorrq_u32(vandq_u32(v, vdupq_n_u32(0x80000000U)), e1);
+    uint32x4_t num = vceqq_f32(x, x);
+    return vbslq_f32(num, vreinterpretq_f32_u32(r), vaddq_f32(x, x));
+}
+
+static float64x2_t
+recpx_df2(float64x2_t x)
+{
+    /*NEON*/
+    uint64x2_t v = vreinterpretq_u64_f64(x);
+    uint64x2_t expmask = vdupq_n_u64(0x7ff0000000000000ULL);
+    uint64x2_t e0 = vandq_u64(v, expmask);
+    uint64x2_t e1 = vbslq_u64(vceqq_u64(e0, vdupq_n_u64(0)),
+			      vdupq_n_u64(0x7fe0000000000000ULL),
+			      vbicq_u64(expmask, v));
+    uint64x2_t sign = vdupq_n_u64(0x8000000000000000ULL);
+    uint64x2_t r = vorrq_u64(vandq_u64(v, sign), e1);
+    uint64x2_t num = vceqq_f64(x, x);
+    return vbslq_f64(num, vreinterpretq_f64_u64(r), vaddq_f64(x, x));
+}
+
+/* (NaNs are processed by a round trip to single-precision). */
+
+static uint16x8_t
+recpx_hf8(uint16x8_t v)
+{
+    /*NEON*/
+    uint16x8_t expmask = vdupq_n_u16(0x7c00);
+    uint16x8_t e0 = vandq_u16(v, expmask);
+    uint16x8_t e1 = vbslq_u16(vceqq_u16(e0, vdupq_n_u16(0)),
+			      vdupq_n_u16(0x7800), vbicq_u16(expmask, v));
+    uint16x8_t r = vorrq_u16(vandq_u16(v, vdupq_n_u16(0x8000)), e1);
+    float16x8_t x = vreinterpretq_f16_u16(v);
+    float16x4_t lo = vcvt_f16_f32(vcvt_f32_f16(vget_low_f16(x)));
+    float16x8_t q = vcvt_high_f16_f32(lo, vcvt_high_f32_f16(x));
+    uint16x8_t num = vcleq_u16(vandq_u16(v, vdupq_n_u16(0x7fff)), expmask);
+    return vbslq_u16(num, r, vreinterpretq_u16_f16(q));
+}
+
+/* MEMO: C99 fmax()/fmin() ignores a nan (on a single side). */
+
+static double
+max_df(double x, double y)
+{
+    if (isnan(x) || isnan(y)) {
+	return nan("");
+    } else {
+	return ((x >= y) ? x : y);
     }
 }
 
@@ -2889,12 +3931,35 @@ min_sf_ignore_nan(float x, float y)
     }
 }
 
-/* Unary operators takes the 2nd argument. */
+/* Unary operators takes the 2nd argument.  Half-precision is
+   computed in single-precision, which rounds once for the basic
+   operations because it has more than twice plus two bits of
+   half-precision. */
 
 static u64
 calculate_fop(int esize, Fop op, u64 ux, u64 uy)
 {
     switch (esize) {
+    case 16: {
+	switch (op) {
+	case Fop_NEG: return (uy ^ 0x8000ULL);
+	case Fop_ABS: return FPAbs(esize, uy);
+	case Fop_CPY: return uy;
+	case Fop_RECPX:
+	    return (u64)vgetq_lane_u16(recpx_hf8(vdupq_n_u16((u16)uy)), 0);
+
+	case Fop_CVTI_16_S16: return FPToFixed(uy, S64EXT, 16, 16);
+	case Fop_CVTI_16_U16: return FPToFixed(uy, U64EXT, 16, 16);
+	case Fop_CVTF_S16_16: return FixedToFP(uy, S64EXT, 16, 16);
+	case Fop_CVTF_U16_16: return FixedToFP(uy, U64EXT, 16, 16);
+
+	default: {
+	    u64 x = FPConvert(ux, 16, 32);
+	    u64 y = FPConvert(uy, 16, 32);
+	    return FPConvert(calculate_fop(32, op, x, y), 32, 16);
+	}
+	}
+    }
     case 32: {
 	float x = u64_as_float(ux);
 	float y = u64_as_float(uy);
@@ -2916,6 +3981,11 @@ calculate_fop(int esize, Fop op, u64 ux, u64 uy)
 	case Fop_RECPS: return float_as_u64(/*NEON*/ vrecpss_f32(x, y));
 	case Fop_RSQRTE: return float_as_u64(/*NEON*/ vrsqrtes_f32(y));
 	case Fop_RSQRTS: return float_as_u64(/*NEON*/ vrsqrtss_f32(x, y));
+	case Fop_RECPX: return float_as_u64(/*NEON*/ vrecpxs_f32(y));
+	case Fop_MULX: return float_as_u64(/*NEON*/ vmulxs_f32(x, y));
+	case Fop_RINTA: case Fop_RINTI: case Fop_RINTM: case Fop_RINTN:
+	case Fop_RINTP: case Fop_RINTX: case Fop_RINTZ:
+	    return float_as_u64(rint_sf(op, y));
 
 	case Fop_DIFF: return FPAbs(esize, float_as_u64(x - y));
 	case Fop_CPY: return uy;
@@ -2947,6 +4017,11 @@ calculate_fop(int esize, Fop op, u64 ux, u64 uy)
 	case Fop_CVTF_U64_32: assert(esize != 32); abort(); break;
 	case Fop_CVTF_U64_64: assert(esize != 32); abort(); break;
 
+	case Fop_CVTI_16_S32: return FPToFixed(uy, S64EXT, 16, 32);
+	case Fop_CVTI_16_U32: return FPToFixed(uy, U64EXT, 16, 32);
+	case Fop_CVTF_S32_16: return FixedToFP(uy, S64EXT, 32, 16);
+	case Fop_CVTF_U32_16: return FixedToFP(uy, U64EXT, 32, 16);
+
 	default:
 	    assert(op == Fop_ADD || op == Fop_DIFF);
 	    abort();
@@ -2973,6 +4048,11 @@ calculate_fop(int esize, Fop op, u64 ux, u64 uy)
 	case Fop_RECPS: return double_as_u64(/*NEON*/ vrecpsd_f64(x, y));
 	case Fop_RSQRTE: return double_as_u64(/*NEON*/ vrsqrted_f64(y));
 	case Fop_RSQRTS: return double_as_u64(/*NEON*/ vrsqrtsd_f64(x, y));
+	case Fop_RECPX: return double_as_u64(/*NEON*/ vrecpxd_f64(y));
+	case Fop_MULX: return double_as_u64(/*NEON*/ vmulxd_f64(x, y));
+	case Fop_RINTA: case Fop_RINTI: case Fop_RINTM: case Fop_RINTN:
+	case Fop_RINTP: case Fop_RINTX: case Fop_RINTZ:
+	    return double_as_u64(rint_df(op, y));
 
 	case Fop_DIFF: return FPAbs(esize, double_as_u64(x - y));
 	case Fop_CPY: return uy;
@@ -3004,17 +4084,546 @@ calculate_fop(int esize, Fop op, u64 ux, u64 uy)
 	case Fop_CVTF_U64_32: return FixedToFP(uy, U64EXT, 64, 32);
 	case Fop_CVTF_U64_64: return FixedToFP(uy, U64EXT, 64, 64);
 
+	case Fop_CVTI_16_S64: return FPToFixed(uy, S64EXT, 16, 64);
+	case Fop_CVTI_16_U64: return FPToFixed(uy, U64EXT, 16, 64);
+	case Fop_CVTF_S64_16: return FixedToFP(uy, S64EXT, 64, 16);
+	case Fop_CVTF_U64_16: return FixedToFP(uy, U64EXT, 64, 16);
+
 	default:
 	    assert(op == Fop_ADD || op == Fop_DIFF);
 	    abort();
 	}
     }
     default:
-	assert(esize == 32 || esize == 64);
+	assert(esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+/* NEON KERNELS of floating-point operators.  They apply an operator
+   on a 128-bit segment at once, and are equivalent to calculate_fop()
+   lane-wise, except that FMAX/FMIN follow the instructions on NaNs
+   and signed zeros.  Conversions are in cvt_kernel_z().  Half-precision
+   uses the FP16 arithmetic (ARMv8.2) when the host has it, or is
+   widened to single-precision otherwise. */
+
+static bool
+fop_kernel_p(int esize, Fop op)
+{
+    if (esize == 16) {
+	if (fp16_kernel == KERNEL_SCALAR) {
+	    return false;
+	}
+    } else if (!(esize == 32 || esize == 64)) {
+	return false;
+    }
+    switch (op) {
+    case Fop_ADD: case Fop_SUB: case Fop_SUB_REV:
+    case Fop_MUL: case Fop_DIV: case Fop_DIV_REV:
+    case Fop_MAX: case Fop_MIN: case Fop_MAXNUM: case Fop_MINNUM:
+    case Fop_NEG: case Fop_ABS: case Fop_SQRT:
+    case Fop_RECPE: case Fop_RECPS: case Fop_RSQRTE: case Fop_RSQRTS:
+    case Fop_RECPX: case Fop_MULX:
+    case Fop_RINTA: case Fop_RINTI: case Fop_RINTM: case Fop_RINTN:
+    case Fop_RINTP: case Fop_RINTX: case Fop_RINTZ:
+    case Fop_DIFF: case Fop_CPY:
+	return true;
+    default:
+	return false;
+    }
+}
+
+static float32x4_t
+fop_kernel_sf(Fop op, float32x4_t x, float32x4_t y)
+{
+    /*NEON*/
+    switch (op) {
+    case Fop_ADD: return vaddq_f32(x, y);
+    case Fop_SUB: return vsubq_f32(x, y);
+    case Fop_SUB_REV: return vsubq_f32(y, x);
+    case Fop_MUL: return vmulq_f32(x, y);
+    case Fop_DIV: return vdivq_f32(x, y);
+    case Fop_DIV_REV: return vdivq_f32(y, x);
+    case Fop_MAX: return vmaxq_f32(x, y);
+    case Fop_MIN: return vminq_f32(x, y);
+    case Fop_MAXNUM: return vmaxnmq_f32(x, y);
+    case Fop_MINNUM: return vminnmq_f32(x, y);
+    case Fop_NEG: return vnegq_f32(y);
+    case Fop_ABS: return vabsq_f32(y);
+    case Fop_SQRT: return vsqrtq_f32(y);
+    case Fop_RECPE: return vrecpeq_f32(y);
+    case Fop_RECPS: return vrecpsq_f32(x, y);
+    case Fop_RSQRTE: return vrsqrteq_f32(y);
+    case Fop_RSQRTS: return vrsqrtsq_f32(x, y);
+    case Fop_RECPX: return recpx_sf4(y);
+    case Fop_MULX: return vmulxq_f32(x, y);
+    case Fop_RINTA: return vrndaq_f32(y);
+    case Fop_RINTI: return vrndiq_f32(y);
+    case Fop_RINTM: return vrndmq_f32(y);
+    case Fop_RINTN: return vrndnq_f32(y);
+    case Fop_RINTP: return vrndpq_f32(y);
+    case Fop_RINTX: return vrndxq_f32(y);
+    case Fop_RINTZ: return vrndq_f32(y);
+    case Fop_DIFF: return vabdq_f32(x, y);
+    case Fop_CPY: return y;
+    default:
+	assert(fop_kernel_p(32, op));
+	abort();
+    }
+}
+
+static float64x2_t
+fop_kernel_df(Fop op, float64x2_t x, float64x2_t y)
+{
+    /*NEON*/
+    switch (op) {
+    case Fop_ADD: return vaddq_f64(x, y);
+    case Fop_SUB: return vsubq_f64(x, y);
+    case Fop_SUB_REV: return vsubq_f64(y, x);
+    case Fop_MUL: return vmulq_f64(x, y);
+    case Fop_DIV: return vdivq_f64(x, y);
+    case Fop_DIV_REV: return vdivq_f64(y, x);
+    case Fop_MAX: return vmaxq_f64(x, y);
+    case Fop_MIN: return vminq_f64(x, y);
+    case Fop_MAXNUM: return vmaxnmq_f64(x, y);
+    case Fop_MINNUM: return vminnmq_f64(x, y);
+    case Fop_NEG: return vnegq_f64(y);
+    case Fop_ABS: return vabsq_f64(y);
+    case Fop_SQRT: return vsqrtq_f64(y);
+    case Fop_RECPE: return vrecpeq_f64(y);
+    case Fop_RECPS: return vrecpsq_f64(x, y);
+    case Fop_RSQRTE: return vrsqrteq_f64(y);
+    case Fop_RSQRTS: return vrsqrtsq_f64(x, y);
+    case Fop_RECPX: return recpx_df2(y);
+    case Fop_MULX: return vmulxq_f64(x, y);
+    case Fop_RINTA: return vrndaq_f64(y);
+    case Fop_RINTI: return vrndiq_f64(y);
+    case Fop_RINTM: return vrndmq_f64(y);
+    case Fop_RINTN: return vrndnq_f64(y);
+    case Fop_RINTP: return vrndpq_f64(y);
+    case Fop_RINTX: return vrndxq_f64(y);
+    case Fop_RINTZ: return vrndq_f64(y);
+    case Fop_DIFF: return vabdq_f64(x, y);
+    case Fop_CPY: return y;
+    default:
+	assert(fop_kernel_p(64, op));
+	abort();
+    }
+}
+
+static uint16x8_t __attribute__ ((target ("arch=armv8.2-a+fp16")))
+fop_kernel_hf_fp16(Fop op, uint16x8_t x0, uint16x8_t y0)
+{
+    float16x8_t x = vreinterpretq_f16_u16(x0);
+    float16x8_t y = vreinterpretq_f16_u16(y0);
+    float16x8_t v;
+    /*NEON*/
+    switch (op) {
+    case Fop_ADD: v = vaddq_f16(x, y); break;
+    case Fop_SUB: v = vsubq_f16(x, y); break;
+    case Fop_SUB_REV: v = vsubq_f16(y, x); break;
+    case Fop_MUL: v = vmulq_f16(x, y); break;
+    case Fop_DIV: v = vdivq_f16(x, y); break;
+    case Fop_DIV_REV: v = vdivq_f16(y, x); break;
+    case Fop_MAX: v = vmaxq_f16(x, y); break;
+    case Fop_MIN: v = vminq_f16(x, y); break;
+    case Fop_MAXNUM: v = vmaxnmq_f16(x, y); break;
+    case Fop_MINNUM: v = vminnmq_f16(x, y); break;
+    case Fop_NEG: v = vnegq_f16(y); break;
+    case Fop_ABS: v = vabsq_f16(y); break;
+    case Fop_SQRT: v = vsqrtq_f16(y); break;
+    case Fop_RECPE: v = vrecpeq_f16(y); break;
+    case Fop_RECPS: v = vrecpsq_f16(x, y); break;
+    case Fop_RSQRTE: v = vrsqrteq_f16(y); break;
+    case Fop_RSQRTS: v = vrsqrtsq_f16(x, y); break;
+    case Fop_RECPX: return recpx_hf8(y0);
+    case Fop_MULX: v = vmulxq_f16(x, y); break;
+    case Fop_RINTA: v = vrndaq_f16(y); break;
+    case Fop_RINTI: v = vrndiq_f16(y); break;
+    case Fop_RINTM: v = vrndmq_f16(y); break;
+    case Fop_RINTN: v = vrndnq_f16(y); break;
+    case Fop_RINTP: v = vrndpq_f16(y); break;
+    case Fop_RINTX: v = vrndxq_f16(y); break;
+    case Fop_RINTZ: v = vrndq_f16(y); break;
+    case Fop_DIFF: v = vabdq_f16(x, y); break;
+    case Fop_CPY: return y0;
+    default:
+	assert(fop_kernel_p(16, op));
+	abort();
+    }
+    return vreinterpretq_u16_f16(v);
+}
+
+/* Computes half-precision in single-precision, which rounds once as
+   in calculate_fop(). */
+
+static uint16x8_t
+fop_kernel_hf_neon(Fop op, uint16x8_t x0, uint16x8_t y0)
+{
+    /*NEON*/
+    switch (op) {
+    case Fop_NEG: return veorq_u16(y0, vdupq_n_u16(0x8000));
+    case Fop_ABS: return vbicq_u16(y0, vdupq_n_u16(0x8000));
+    case Fop_RECPX: return recpx_hf8(y0);
+    case Fop_CPY: return y0;
+    default: {
+	float16x8_t x = vreinterpretq_f16_u16(x0);
+	float16x8_t y = vreinterpretq_f16_u16(y0);
+	float32x4_t lo = fop_kernel_sf(op, vcvt_f32_f16(vget_low_f16(x)),
+				       vcvt_f32_f16(vget_low_f16(y)));
+	float32x4_t hi = fop_kernel_sf(op, vcvt_high_f32_f16(x),
+				       vcvt_high_f32_f16(y));
+	float16x8_t v = vcvt_high_f16_f32(vcvt_f16_f32(lo), hi);
+	return vreinterpretq_u16_f16(v);
+    }
+    }
+}
+
+/* Computes Z := op(X, Y) on the active elements, and Z := X on the
+   inactive ones. */
+
+static void
+fop_kernel_z(svecxt_t *zx, int esize, Fop op, preg *mask,
+	     zreg *x, zreg *y, zreg *z)
+{
+    assert(fop_kernel_p(esize, op));
+    int segments = zx->VL / 128;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	if (esize == 16) {
+	    int e = (8 * i);
+	    uint16x8_t vx = vld1q_u16(&x->h[e]);
+	    uint16x8_t vy = vld1q_u16(&y->h[e]);
+	    uint16x8_t v = ((fp16_kernel == KERNEL_FP16)
+			    ? fop_kernel_hf_fp16(op, vx, vy)
+			    : fop_kernel_hf_neon(op, vx, vy));
+	    uint16x8_t m = ElemP_lanes16(zx, mask, e);
+	    vst1q_u16(&z->h[e], vbslq_u16(m, v, vx));
+	} else if (esize == 32) {
+	    int e = (4 * i);
+	    uint32x4_t vx = vld1q_u32(&x->w[e]);
+	    uint32x4_t vy = vld1q_u32(&y->w[e]);
+	    float32x4_t v = fop_kernel_sf(op, vreinterpretq_f32_u32(vx),
+					  vreinterpretq_f32_u32(vy));
+	    uint32x4_t m = ElemP_lanes32(zx, mask, e);
+	    vst1q_u32(&z->w[e], vbslq_u32(m, vreinterpretq_u32_f32(v), vx));
+	} else {
+	    int e = (2 * i);
+	    uint64x2_t vx = vld1q_u64(&x->x[e]);
+	    uint64x2_t vy = vld1q_u64(&y->x[e]);
+	    float64x2_t v = fop_kernel_df(op, vreinterpretq_f64_u64(vx),
+					  vreinterpretq_f64_u64(vy));
+	    uint64x2_t m = ElemP_lanes64(zx, mask, e);
+	    vst1q_u64(&z->x[e], vbslq_u64(m, vreinterpretq_u64_f64(v), vx));
+	}
+    }
+}
+
+/* NEON KERNELS of conversions.  A narrower operand or result is in
+   the low bits of an element (unpacked), and a result is extended to
+   the element size.  Conversions to integers saturate and make NaNs
+   zero as the instructions do.  Half-precision is widened to
+   single-precision, which is exact, and integers converted to
+   half-precision are exact in single-precision up to 2^24, where
+   larger ones overflow anyway. */
+
+static bool
+cvt_kernel_p(int esize, Fop op)
+{
+    if (cvt_kernel == KERNEL_SCALAR) {
+	return false;
+    }
+    switch (esize) {
+    case 16:
+	switch (op) {
+	case Fop_CVTI_16_S16: case Fop_CVTI_16_U16:
+	case Fop_CVTF_S16_16: case Fop_CVTF_U16_16:
+	    return true;
+	default:
+	    return false;
+	}
+    case 32:
+	switch (op) {
+	case Fop_CVT_16_32: case Fop_CVT_32_16:
+	case Fop_CVTI_32_S32: case Fop_CVTI_32_U32:
+	case Fop_CVTI_16_S32: case Fop_CVTI_16_U32:
+	case Fop_CVTF_S32_32: case Fop_CVTF_U32_32:
+	case Fop_CVTF_S32_16: case Fop_CVTF_U32_16:
+	    return true;
+	default:
+	    return false;
+	}
+    case 64:
+	switch (op) {
+	case Fop_CVT_16_64: case Fop_CVT_32_64:
+	case Fop_CVT_64_16: case Fop_CVT_64_32:
+	case Fop_CVTI_32_S64: case Fop_CVTI_64_S32: case Fop_CVTI_64_S64:
+	case Fop_CVTI_32_U64: case Fop_CVTI_64_U32: case Fop_CVTI_64_U64:
+	case Fop_CVTI_16_S64: case Fop_CVTI_16_U64:
+	case Fop_CVTF_S32_64: case Fop_CVTF_S64_32: case Fop_CVTF_S64_64:
+	case Fop_CVTF_U32_64: case Fop_CVTF_U64_32: case Fop_CVTF_U64_64:
+	case Fop_CVTF_S64_16: case Fop_CVTF_U64_16:
+	    return true;
+	default:
+	    return false;
+	}
+    default:
+	return false;
+    }
+}
+
+/* Converts 64-bit integers to single-precision by a single rounding.
+   Integers beyond 2^53 are rounded to odd at 2^11 (the shifted-out
+   bits are kept as a sticky bit), so that the conversion to
+   double-precision is exact. */
+
+static float32x2_t
+cvtf_s64_sf2(int64x2_t x)
+{
+    /*NEON*/
+    uint64x2_t big = vcgtq_u64(vreinterpretq_u64_s64(vabsq_s64(x)),
+			       vdupq_n_u64((1ULL << 53) - 1));
+    int64x2_t sticky = vreinterpretq_s64_u64(
+	vandq_u64(vtstq_s64(x, vdupq_n_s64(0x7ff)), vdupq_n_u64(1)));
+    int64x2_t y = vorrq_s64(vshrq_n_s64(x, 11), sticky);
+    float64x2_t fy = vmulq_n_f64(vcvtq_f64_s64(y), 2048.0);
+    float64x2_t v = vbslq_f64(big, fy, vcvtq_f64_s64(x));
+    return vcvt_f32_f64(v);
+}
+
+static float32x2_t
+cvtf_u64_sf2(uint64x2_t x)
+{
+    /*NEON*/
+    uint64x2_t big = vcgtq_u64(x, vdupq_n_u64((1ULL << 53) - 1));
+    uint64x2_t sticky = vandq_u64(vtstq_u64(x, vdupq_n_u64(0x7ff)),
+				  vdupq_n_u64(1));
+    uint64x2_t y = vorrq_u64(vshrq_n_u64(x, 11), sticky);
+    float64x2_t fy = vmulq_n_f64(vcvtq_f64_u64(y), 2048.0);
+    float64x2_t v = vbslq_f64(big, fy, vcvtq_f64_u64(x));
+    return vcvt_f32_f64(v);
+}
+
+/* Makes half-precision of single-precision in the low bits of
+   32-bit lanes, and its inverse. */
+
+static uint32x4_t
+hf_of_sf4(float32x4_t x)
+{
+    /*NEON*/
+    return vmovl_u16(vreinterpret_u16_f16(vcvt_f16_f32(x)));
+}
+
+static float32x4_t
+sf_of_hf4(uint32x4_t x)
+{
+    /*NEON*/
+    return vcvt_f32_f16(vreinterpret_f16_u16(vmovn_u32(x)));
+}
+
+/* Takes single-precision in the low bits of 64-bit lanes, and its
+   inverse.  Half-precision there is widened to double-precision. */
+
+static float32x2_t
+sf_of_lanes64(uint64x2_t x)
+{
+    /*NEON*/
+    return vreinterpret_f32_u32(vmovn_u64(x));
+}
+
+static uint64x2_t
+lanes64_of_sf(float32x2_t x)
+{
+    /*NEON*/
+    return vmovl_u32(vreinterpret_u32_f32(x));
+}
+
+static float64x2_t
+df_of_hf_lanes64(uint64x2_t x)
+{
+    /*NEON*/
+    float32x4_t v = sf_of_hf4(vreinterpretq_u32_u64(x));
+    return vcvt_f64_f32(vuzp1_f32(vget_low_f32(v), vget_high_f32(v)));
+}
+
+static uint16x8_t
+cvt_kernel_16(Fop op, uint16x8_t y)
+{
+    /*NEON*/
+    switch (op) {
+    case Fop_CVTI_16_S16: {
+	float16x8_t x = vreinterpretq_f16_u16(y);
+	int32x4_t lo = vcvtq_s32_f32(vcvt_f32_f16(vget_low_f16(x)));
+	int32x4_t hi = vcvtq_s32_f32(vcvt_high_f32_f16(x));
+	int16x8_t v = vqmovn_high_s32(vqmovn_s32(lo), hi);
+	return vreinterpretq_u16_s16(v);
+    }
+    case Fop_CVTI_16_U16: {
+	float16x8_t x = vreinterpretq_f16_u16(y);
+	uint32x4_t lo = vcvtq_u32_f32(vcvt_f32_f16(vget_low_f16(x)));
+	uint32x4_t hi = vcvtq_u32_f32(vcvt_high_f32_f16(x));
+	return vqmovn_high_u32(vqmovn_u32(lo), hi);
+    }
+    case Fop_CVTF_S16_16: {
+	int16x8_t x = vreinterpretq_s16_u16(y);
+	float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x)));
+	float32x4_t hi = vcvtq_f32_s32(vmovl_high_s16(x));
+	float16x8_t v = vcvt_high_f16_f32(vcvt_f16_f32(lo), hi);
+	return vreinterpretq_u16_f16(v);
+    }
+    case Fop_CVTF_U16_16: {
+	float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(y)));
+	float32x4_t hi = vcvtq_f32_u32(vmovl_high_u16(y));
+	float16x8_t v = vcvt_high_f16_f32(vcvt_f16_f32(lo), hi);
+	return vreinterpretq_u16_f16(v);
+    }
+    default:
+	assert(op == Fop_CVTI_16_S16);
+	abort();
+    }
+}
+
+static uint32x4_t
+cvt_kernel_32(Fop op, uint32x4_t y)
+{
+    /*NEON*/
+    float32x4_t f = vreinterpretq_f32_u32(y);
+    switch (op) {
+    case Fop_CVT_16_32:
+	return vreinterpretq_u32_f32(sf_of_hf4(y));
+    case Fop_CVT_32_16:
+	return hf_of_sf4(f);
+
+    case Fop_CVTI_32_S32:
+	return vreinterpretq_u32_s32(vcvtq_s32_f32(f));
+    case Fop_CVTI_32_U32:
+	return vcvtq_u32_f32(f);
+    case Fop_CVTI_16_S32:
+	return vreinterpretq_u32_s32(vcvtq_s32_f32(sf_of_hf4(y)));
+    case Fop_CVTI_16_U32:
+	return vcvtq_u32_f32(sf_of_hf4(y));
+
+    case Fop_CVTF_S32_32:
+	return vreinterpretq_u32_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(y)));
+    case Fop_CVTF_U32_32:
+	return vreinterpretq_u32_f32(vcvtq_f32_u32(y));
+    case Fop_CVTF_S32_16:
+	return hf_of_sf4(vcvtq_f32_s32(vreinterpretq_s32_u32(y)));
+    case Fop_CVTF_U32_16:
+	return hf_of_sf4(vcvtq_f32_u32(y));
+
+    default:
+	assert(op == Fop_CVT_16_32);
+	abort();
+    }
+}
+
+static uint64x2_t
+cvt_kernel_64(Fop op, uint64x2_t y)
+{
+    /*NEON*/
+    float64x2_t f = vreinterpretq_f64_u64(y);
+    int64x2_t s = vreinterpretq_s64_u64(y);
+    switch (op) {
+    case Fop_CVT_16_64:
+	return vreinterpretq_u64_f64(df_of_hf_lanes64(y));
+    case Fop_CVT_32_64:
+	return vreinterpretq_u64_f64(vcvt_f64_f32(sf_of_lanes64(y)));
+    case Fop_CVT_64_16: {
+	float32x2_t x = vcvtx_f32_f64(f);
+	uint32x4_t v = hf_of_sf4(vcombine_f32(x, x));
+	return vmovl_u32(vget_low_u32(v));
+    }
+    case Fop_CVT_64_32:
+	return lanes64_of_sf(vcvt_f32_f64(f));
+
+    case Fop_CVTI_32_S64: {
+	float64x2_t x = vcvt_f64_f32(sf_of_lanes64(y));
+	return vreinterpretq_u64_s64(vcvtq_s64_f64(x));
+    }
+    case Fop_CVTI_64_S32: {
+	int32x2_t v = vqmovn_s64(vcvtq_s64_f64(f));
+	return vreinterpretq_u64_s64(vmovl_s32(v));
+    }
+    case Fop_CVTI_64_S64:
+	return vreinterpretq_u64_s64(vcvtq_s64_f64(f));
+    case Fop_CVTI_32_U64:
+	return vcvtq_u64_f64(vcvt_f64_f32(sf_of_lanes64(y)));
+    case Fop_CVTI_64_U32:
+	return vmovl_u32(vqmovn_u64(vcvtq_u64_f64(f)));
+    case Fop_CVTI_64_U64:
+	return vcvtq_u64_f64(f);
+    case Fop_CVTI_16_S64:
+	return vreinterpretq_u64_s64(vcvtq_s64_f64(df_of_hf_lanes64(y)));
+    case Fop_CVTI_16_U64:
+	return vcvtq_u64_f64(df_of_hf_lanes64(y));
+
+    case Fop_CVTF_S32_64: {
+	int64x2_t x = vmovl_s32(vmovn_s64(s));
+	return vreinterpretq_u64_f64(vcvtq_f64_s64(x));
+    }
+    case Fop_CVTF_S64_32:
+	return lanes64_of_sf(cvtf_s64_sf2(s));
+    case Fop_CVTF_S64_64:
+	return vreinterpretq_u64_f64(vcvtq_f64_s64(s));
+    case Fop_CVTF_U32_64: {
+	uint64x2_t x = vmovl_u32(vmovn_u64(y));
+	return vreinterpretq_u64_f64(vcvtq_f64_u64(x));
+    }
+    case Fop_CVTF_U64_32:
+	return lanes64_of_sf(cvtf_u64_sf2(y));
+    case Fop_CVTF_U64_64:
+	return vreinterpretq_u64_f64(vcvtq_f64_u64(y));
+    case Fop_CVTF_S64_16: {
+	float32x2_t x = vcvt_f32_f64(vcvtq_f64_s64(s));
+	uint32x4_t v = hf_of_sf4(vcombine_f32(x, x));
+	return vmovl_u32(vget_low_u32(v));
+    }
+    case Fop_CVTF_U64_16: {
+	float32x2_t x = vcvt_f32_f64(vcvtq_f64_u64(y));
+	uint32x4_t v = hf_of_sf4(vcombine_f32(x, x));
+	return vmovl_u32(vget_low_u32(v));
+    }
+
+    default:
+	assert(op == Fop_CVT_16_64);
 	abort();
     }
 }
 
+/* Computes Z := op(Y) on the active elements, and Z := X on the
+   inactive ones. */
+
+static void
+cvt_kernel_z(svecxt_t *zx, int esize, Fop op, preg *mask,
+	     zreg *x, zreg *y, zreg *z)
+{
+    assert(cvt_kernel_p(esize, op));
+    int segments = zx->VL / 128;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	if (esize == 16) {
+	    int e = (8 * i);
+	    uint16x8_t vx = vld1q_u16(&x->h[e]);
+	    uint16x8_t v = cvt_kernel_16(op, vld1q_u16(&y->h[e]));
+	    uint16x8_t m = ElemP_lanes16(zx, mask, e);
+	    vst1q_u16(&z->h[e], vbslq_u16(m, v, vx));
+	} else if (esize == 32) {
+	    int e = (4 * i);
+	    uint32x4_t vx = vld1q_u32(&x->w[e]);
+	    uint32x4_t v = cvt_kernel_32(op, vld1q_u32(&y->w[e]));
+	    uint32x4_t m = ElemP_lanes32(zx, mask, e);
+	    vst1q_u32(&z->w[e], vbslq_u32(m, v, vx));
+	} else {
+	    int e = (2 * i);
+	    uint64x2_t vx = vld1q_u64(&x->x[e]);
+	    uint64x2_t v = cvt_kernel_64(op, vld1q_u64(&y->x[e]));
+	    uint64x2_t m = ElemP_lanes64(zx, mask, e);
+	    vst1q_u64(&z->x[e], vbslq_u64(m, v, vx));
+	}
+    }
+}
+
 static void
 perform_INC_x(svecxt_t *zx, int esize, int Rdn, int pat, s64 imm)
 {
@@ -3053,15 +4662,9 @@ perform_INC_x_pred(svecxt_t *zx, int esize, int Rdn, int Pg, int increment)
     CheckSVEEnabled();
 
     assert(increment == 1 || increment == -1);
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
+    preg *mask = &zx->p[Pg];
     u64 operand = Xreg_get(zx, Rdn, X31ZERO);
-    int count = 0;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    count = count + increment;
-	}
-    }
+    int count = preg_count(zx, mask, mask, esize) * increment;
     Xreg_set(zx, Rdn, (u64)((s64)operand + count));
 }
 
@@ -3073,15 +4676,10 @@ perform_INC_z_pred(svecxt_t *zx, int esize, int Zdn, int Pg, int increment)
     CheckSVEEnabled();
 
     int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
+    preg *mask = &zx->p[Pg];
     zreg operand = zx->z[Zdn];
     zreg result = zreg_zeros;
-    int count = 0;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    count = count + increment;
-	}
-    }
+    int count = preg_count(zx, mask, mask, esize) * increment;
     for (int e = 0; e < elements; e++) {
 	u64 v = Elem_get(zx, &operand, e, esize, DONTCARE);
 	Elem_set(zx, &result, e, esize, (u64)((s64)v + count));
@@ -3089,54 +4687,377 @@ perform_INC_z_pred(svecxt_t *zx, int esize, int Zdn, int Pg, int increment)
     zx->z[Zdn] = result;
 }
 
+/* Saturating increments (SQINC/SQDEC/UQINC/UQDEC) by an element
+   count.  SSIZE is the size of a scalar operand, and the result is
+   extended to 64 bits by the signedness.  The increment is small
+   (at most 16 times the elements), and SatQ2() saturates it in the
+   closed form. */
+
 static void
-perform_ADR(svecxt_t *zx, int esize, int osize, int mbytes, bool unsignedp,
-	    int Zn, int Zm, int Zd)
+qinc_x(svecxt_t *zx, int ssize, bool unsignedp, int Rdn, s64 increment)
+{
+    u64 operand1 = Xreg_get(zx, Rdn, X31ZERO);
+    s64 element1 = (s64)sign_extend(operand1, ssize, unsignedp);
+    saturated_t result = SatQ2(element1, increment, ssize, unsignedp);
+    Xreg_set(zx, Rdn, sign_extend(result.v, ssize, unsignedp));
+}
+
+static void
+qinc_z(svecxt_t *zx, int esize, bool unsignedp, int Zdn, s64 increment)
+{
+    assert(esize == 16 || esize == 32 || esize == 64);
+    zreg *z = &zx->z[Zdn];
+    bool down = (increment < 0);
+    u64 d = (down ? (u64)-increment : (u64)increment);
+    /*NEON*/
+    for (int i = 0; i < (zx->VL / 64); i += 2) {
+	uint64x2_t v = vld1q_u64(&z->x[i]);
+	uint64x2_t r;
+	switch (esize) {
+	case 16: {
+	    uint16x8_t a = vreinterpretq_u16_u64(v);
+	    if (unsignedp) {
+		uint16x8_t b = vdupq_n_u16((u16)d);
+		r = vreinterpretq_u64_u16(down ? vqsubq_u16(a, b)
+					  : vqaddq_u16(a, b));
+	    } else {
+		int16x8_t b = vdupq_n_s16((s16)increment);
+		r = vreinterpretq_u64_s16(vqaddq_s16(vreinterpretq_s16_u16(a),
+						     b));
+	    }
+	    break;
+	}
+	case 32: {
+	    uint32x4_t a = vreinterpretq_u32_u64(v);
+	    if (unsignedp) {
+		uint32x4_t b = vdupq_n_u32((u32)d);
+		r = vreinterpretq_u64_u32(down ? vqsubq_u32(a, b)
+					  : vqaddq_u32(a, b));
+	    } else {
+		int32x4_t b = vdupq_n_s32((s32)increment);
+		r = vreinterpretq_u64_s32(vqaddq_s32(vreinterpretq_s32_u32(a),
+						     b));
+	    }
+	    break;
+	}
+	default: {
+	    if (unsignedp) {
+		uint64x2_t b = vdupq_n_u64(d);
+		r = (down ? vqsubq_u64(v, b) : vqaddq_u64(v, b));
+	    } else {
+		int64x2_t b = vdupq_n_s64(increment);
+		r = vreinterpretq_u64_s64(vqaddq_s64(vreinterpretq_s64_u64(v),
+						     b));
+	    }
+	    break;
+	}
+	}
+	vst1q_u64(&z->x[i], r);
+    }
+}
+
+static void
+perform_QINC_x(svecxt_t *zx, int esize, int ssize, bool unsignedp,
+	       int Rdn, int pat, s64 imm)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    assert(osize <= esize);
-    int elements = zx->VL / esize;
-    zreg base = zx->z[Zn];
-    zreg offs = zx->z[Zm];
-    zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 addr = Elem_get(zx, &base, e, esize, DONTCARE);
-	u64 off0 = Elem_get(zx, &offs, e, esize, DONTCARE);
-	s64 offset = (s64)sign_extend(off0, osize, unsignedp);
-	Elem_set(zx, &result, e, esize, (u64)((s64)addr + (offset * mbytes)));
-    }
-    zx->z[Zd] = result;
+    int count = DecodePredCount(zx, pat, esize);
+    qinc_x(zx, ssize, unsignedp, Rdn, (count * imm));
 }
 
-/* Sign-extends. */
+static void
+perform_QINC_z(svecxt_t *zx, int esize, bool unsignedp,
+	       int Zdn, int pat, s64 imm)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int count = DecodePredCount(zx, pat, esize);
+    qinc_z(zx, esize, unsignedp, Zdn, (count * imm));
+}
 
 static void
-perform_EXTEND(svecxt_t *zx, int esize, int src_esize, bool unsignedp,
-	       int Zn, int Zd, int Pg)
+perform_QINC_x_pred(svecxt_t *zx, int esize, int ssize, bool unsignedp,
+		    int Rdn, int Pg, int increment)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
+    assert(increment == 1 || increment == -1);
+    preg *mask = &zx->p[Pg];
+    int count = preg_count(zx, mask, mask, esize);
+    qinc_x(zx, ssize, unsignedp, Rdn, (count * increment));
+}
+
+static void
+perform_QINC_z_pred(svecxt_t *zx, int esize, bool unsignedp,
+		    int Zdn, int Pg, int increment)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(increment == 1 || increment == -1);
+    preg *mask = &zx->p[Pg];
+    int count = preg_count(zx, mask, mask, esize);
+    qinc_z(zx, esize, unsignedp, Zdn, (count * increment));
+}
+
+static void
+perform_ADR(svecxt_t *zx, int esize, int osize, int mbytes, bool unsignedp,
+	    int Zn, int Zm, int Zd)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(osize <= esize);
+    int elements = zx->VL / esize;
+    zreg base = zx->z[Zn];
+    zreg offs = zx->z[Zm];
+    zreg result = zreg_zeros;
+    for (int e = 0; e < elements; e++) {
+	u64 addr = Elem_get(zx, &base, e, esize, DONTCARE);
+	u64 off0 = Elem_get(zx, &offs, e, esize, DONTCARE);
+	s64 offset = (s64)sign_extend(off0, osize, unsignedp);
+	Elem_set(zx, &result, e, esize, (u64)((s64)addr + (offset * mbytes)));
+    }
+    zx->z[Zd] = result;
+}
+
+/* Sign-extends (or zero-extends) the low bits of elements.  Zero
+   extension is by a mask, and sign extension is by a pair of left and
+   arithmetic right shifts. */
+
+static uint8x16_t
+extend_kernel(int esize, int src_esize, bool unsignedp, uint8x16_t x)
+{
+    /*NEON*/
+    if (unsignedp) {
+	u64 m = ((1ULL << src_esize) - 1);
+	return vandq_u8(x, Replicate_q(esize, m));
+    }
+    int n = (esize - src_esize);
+    switch (esize) {
+    case 16: {
+	int16x8_t c = vdupq_n_s16((s16)n);
+	int16x8_t v = vshlq_s16(vshlq_s16(vreinterpretq_s16_u8(x), c),
+				vnegq_s16(c));
+	return vreinterpretq_u8_s16(v);
+    }
+    case 32: {
+	int32x4_t c = vdupq_n_s32(n);
+	int32x4_t v = vshlq_s32(vshlq_s32(vreinterpretq_s32_u8(x), c),
+				vnegq_s32(c));
+	return vreinterpretq_u8_s32(v);
+    }
+    case 64: {
+	int64x2_t c = vdupq_n_s64(n);
+	int64x2_t v = vshlq_s64(vshlq_s64(vreinterpretq_s64_u8(x), c),
+				vnegq_s64(c));
+	return vreinterpretq_u8_s64(v);
+    }
+    default:
+	assert(esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+static void
+perform_EXTEND(svecxt_t *zx, int esize, int src_esize, bool unsignedp,
+	       int Zn, int Zd, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(src_esize < esize);
+    int segments = zx->VL / 128;
+    int lanes = 128 / esize;
     preg mask = zx->p[Pg];
     zreg operand = zx->z[Zn];
     zreg dest = zx->z[Zd];
     zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 element = Elem_get(zx, &operand, e, esize, unsignedp);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 v = sign_extend(element, src_esize, unsignedp);
-	    Elem_set(zx, &result, e, esize, v);
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	uint8x16_t x = vld1q_u8(&operand.b[16 * i]);
+	uint8x16_t v = extend_kernel(esize, src_esize, unsignedp, x);
+	uint8x16_t k = ElemP_lanes(zx, &mask, (lanes * i), esize);
+	vst1q_u8(&result.b[16 * i],
+		 vbslq_u8(k, v, vld1q_u8(&dest.b[16 * i])));
+    }
+    zx->z[Zd] = result;
+}
+
+/* NEON KERNELS of shifts.  A kernel shifts the X lanes by the Y lanes
+   (unsigned amounts), or the Y lanes by the X lanes for the reversed
+   ones.  The amounts are clamped to the element size, where vshlq
+   (with negated amounts for right shifts) gives the architectural
+   results, zeros by LSL/LSR and the sign bits by ASR.  ASRD rounds
+   toward zero by adding one to the quotient of a negative dividend
+   with nonzero bits shifted out. */
+
+static bool
+shift_kernel_p(Iop op)
+{
+    return (op == Iop_ASH_R || op == Iop_ASH_R_REV || op == Iop_ASH_DIV
+	    || op == Iop_LSH_L || op == Iop_LSH_L_REV
+	    || op == Iop_LSH_R || op == Iop_LSH_R_REV);
+}
+
+static uint8x16_t
+shift_kernel(int esize, Iop op, uint8x16_t x0, uint8x16_t y0)
+{
+    bool revp = (op == Iop_ASH_R_REV || op == Iop_LSH_L_REV
+		 || op == Iop_LSH_R_REV);
+    Iop op1 = ((op == Iop_ASH_R_REV) ? Iop_ASH_R
+	       : (op == Iop_LSH_L_REV) ? Iop_LSH_L
+	       : (op == Iop_LSH_R_REV) ? Iop_LSH_R : op);
+    bool leftp = (op1 == Iop_LSH_L);
+    uint8x16_t x = (revp ? y0 : x0);
+    uint8x16_t y = (revp ? x0 : y0);
+    /*NEON*/
+    switch (esize) {
+    case 8: {
+	uint8x16_t n = vminq_u8(y, vdupq_n_u8(8));
+	int8x16_t sn = vreinterpretq_s8_u8(n);
+	int8x16_t c = (leftp ? sn : vnegq_s8(sn));
+	int8x16_t sx = vreinterpretq_s8_u8(x);
+	switch (op1) {
+	case Iop_LSH_L: case Iop_LSH_R:
+	    return vshlq_u8(x, c);
+	case Iop_ASH_R:
+	    return vreinterpretq_u8_s8(vshlq_s8(sx, c));
+	case Iop_ASH_DIV: {
+	    uint8x16_t q = vreinterpretq_u8_s8(vshlq_s8(sx, c));
+	    uint8x16_t low = vshlq_u8(vdupq_n_u8(0xff),
+				      vsubq_s8(sn, vdupq_n_s8(8)));
+	    uint8x16_t up = vandq_u8(vtstq_u8(x, low), vcltzq_s8(sx));
+	    return vsubq_u8(q, up);
+	}
+	default:
+	    break;
+	}
+	break;
+    }
+    case 16: {
+	uint16x8_t ux = vreinterpretq_u16_u8(x);
+	uint16x8_t n = vminq_u16(vreinterpretq_u16_u8(y), vdupq_n_u16(16));
+	int16x8_t sn = vreinterpretq_s16_u16(n);
+	int16x8_t c = (leftp ? sn : vnegq_s16(sn));
+	int16x8_t sx = vreinterpretq_s16_u8(x);
+	switch (op1) {
+	case Iop_LSH_L: case Iop_LSH_R:
+	    return vreinterpretq_u8_u16(vshlq_u16(ux, c));
+	case Iop_ASH_R:
+	    return vreinterpretq_u8_s16(vshlq_s16(sx, c));
+	case Iop_ASH_DIV: {
+	    uint16x8_t q = vreinterpretq_u16_s16(vshlq_s16(sx, c));
+	    uint16x8_t low = vshlq_u16(vdupq_n_u16(0xffff),
+				       vsubq_s16(sn, vdupq_n_s16(16)));
+	    uint16x8_t up = vandq_u16(vtstq_u16(ux, low), vcltzq_s16(sx));
+	    return vreinterpretq_u8_u16(vsubq_u16(q, up));
+	}
+	default:
+	    break;
+	}
+	break;
+    }
+    case 32: {
+	uint32x4_t ux = vreinterpretq_u32_u8(x);
+	uint32x4_t n = vminq_u32(vreinterpretq_u32_u8(y), vdupq_n_u32(32));
+	int32x4_t sn = vreinterpretq_s32_u32(n);
+	int32x4_t c = (leftp ? sn : vnegq_s32(sn));
+	int32x4_t sx = vreinterpretq_s32_u8(x);
+	switch (op1) {
+	case Iop_LSH_L: case Iop_LSH_R:
+	    return vreinterpretq_u8_u32(vshlq_u32(ux, c));
+	case Iop_ASH_R:
+	    return vreinterpretq_u8_s32(vshlq_s32(sx, c));
+	case Iop_ASH_DIV: {
+	    uint32x4_t q = vreinterpretq_u32_s32(vshlq_s32(sx, c));
+	    uint32x4_t low = vshlq_u32(vdupq_n_u32(~0U),
+				       vsubq_s32(sn, vdupq_n_s32(32)));
+	    uint32x4_t up = vandq_u32(vtstq_u32(ux, low), vcltzq_s32(sx));
+	    return vreinterpretq_u8_u32(vsubq_u32(q, up));
+	}
+	default:
+	    break;
+	}
+	break;
+    }
+    case 64: {
+	uint64x2_t ux = vreinterpretq_u64_u8(x);
+	uint64x2_t uy = vreinterpretq_u64_u8(y);
+	uint64x2_t cap = vdupq_n_u64(64);
+	uint64x2_t n = vbslq_u64(vcgtq_u64(uy, cap), cap, uy);
+	int64x2_t sn = vreinterpretq_s64_u64(n);
+	int64x2_t c = (leftp ? sn : vnegq_s64(sn));
+	int64x2_t sx = vreinterpretq_s64_u8(x);
+	switch (op1) {
+	case Iop_LSH_L: case Iop_LSH_R:
+	    return vreinterpretq_u8_u64(vshlq_u64(ux, c));
+	case Iop_ASH_R:
+	    return vreinterpretq_u8_s64(vshlq_s64(sx, c));
+	case Iop_ASH_DIV: {
+	    uint64x2_t q = vreinterpretq_u64_s64(vshlq_s64(sx, c));
+	    uint64x2_t low = vshlq_u64(vdupq_n_u64(~0ULL),
+				       vsubq_s64(sn, vdupq_n_s64(64)));
+	    uint64x2_t up = vandq_u64(vtstq_u64(ux, low), vcltzq_s64(sx));
+	    return vreinterpretq_u8_u64(vsubq_u64(q, up));
+	}
+	default:
+	    break;
+	}
+	break;
+    }
+    default:
+	break;
+    }
+    assert((esize == 8 || esize == 16 || esize == 32 || esize == 64)
+	   && shift_kernel_p(op));
+    abort();
+}
+
+/* Computes Z := op(X, Y) on the active elements, and Z := X on the
+   inactive ones.  The wide elements of Y are 64-bit amounts for the
+   elements in the same 64 bits, which are read once for a segment.
+   They are clamped here, because the kernel takes the amounts in the
+   element size. */
+
+static void
+shift_kernel_z(svecxt_t *zx, int esize, Iop op, bool wide2ndp,
+	       preg *mask, zreg *x, zreg *y, zreg *z)
+{
+    assert(shift_kernel_p(op));
+    assert(!wide2ndp || esize != 64);
+    int segments = zx->VL / 128;
+    int lanes = 128 / esize;
+    u64 cap = (u64)esize;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	uint8x16_t vx = vld1q_u8(&x->b[16 * i]);
+	uint8x16_t vy;
+	if (!wide2ndp) {
+	    vy = vld1q_u8(&y->b[16 * i]);
 	} else {
-	    u64 v = Elem_get(zx, &dest, e, esize, DONTCARE);
-	    Elem_set(zx, &result, e, esize, v);
+	    u64 y0 = y->x[2 * i];
+	    u64 y1 = y->x[2 * i + 1];
+	    y0 = ((y0 < cap) ? y0 : cap);
+	    y1 = ((y1 < cap) ? y1 : cap);
+	    uint64x2_t y2 = vcombine_u64(vcreate_u64(Replicate(64, esize, y0)),
+					 vcreate_u64(Replicate(64, esize, y1)));
+	    vy = vreinterpretq_u8_u64(y2);
 	}
+	uint8x16_t v = shift_kernel(esize, op, vx, vy);
+	uint8x16_t k = ElemP_lanes(zx, mask, (lanes * i), esize);
+	vst1q_u8(&z->b[16 * i], vbslq_u8(k, v, vx));
     }
-    zx->z[Zd] = result;
 }
 
 static void
@@ -3147,16 +5068,21 @@ perform_IOP_z_wide2nd(svecxt_t *zx, int esize, bool wide2ndp, Iop op,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    enum signedness signedp = ((op == Iop_ASH_R) ? S64EXT : DONTCARE);
-
     int elements = zx->VL / esize;
     zreg operand1 = zx->z[Zn];
     zreg operand2 = zx->z[Zm];
     zreg result = zreg_zeros;
+    if (shift_kernel_p(op)) {
+	preg mask = preg_all_ones;
+	shift_kernel_z(zx, esize, op, wide2ndp, &mask,
+		       &operand1, &operand2, &result);
+	zx->z[Zd] = result;
+	return;
+    }
+    assert(!wide2ndp);
     for (int e = 0; e < elements; e++) {
-	int e2 = ((!wide2ndp) ? e : ((e * esize) / 64));
-	u64 element1 = Elem_get(zx, &operand1, e, esize, signedp);
-	u64 element2 = Elem_get(zx, &operand2, e2, esize, DONTCARE);
+	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
+	u64 element2 = Elem_get(zx, &operand2, e, esize, DONTCARE);
 	u64 v = calculate_iop(esize, op, element1, element2);
 	Elem_set(zx, &result, e, esize, v);
     }
@@ -3181,6 +5107,14 @@ perform_IOP_z_imm(svecxt_t *zx, int esize, Iop op,
     int elements = zx->VL / esize;
     zreg operand1 = zx->z[Zn];
     zreg result = zreg_zeros;
+    if (shift_kernel_p(op)) {
+	preg mask = preg_all_ones;
+	zreg operand2 = Replicate_z(zx, esize, imm);
+	shift_kernel_z(zx, esize, op, false, &mask,
+		       &operand1, &operand2, &result);
+	zx->z[Zd] = result;
+	return;
+    }
     for (int e = 0; e < elements; e++) {
 	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
 	u64 element2 = imm;
@@ -3198,23 +5132,14 @@ perform_IOP_z_imm_pred(svecxt_t *zx, int esize, Iop op,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    assert(op == Iop_ASH_R);
+    assert(shift_kernel_p(op));
 
-    int elements = zx->VL / esize;
     zreg operand1 = zx->z[Zdn];
+    zreg operand2 = Replicate_z(zx, esize, imm);
     preg mask = zx->p[Pg];
     zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	    u64 element2 = imm;
-	    u64 v = calculate_iop(esize, op, element1, element2);
-	    Elem_set(zx, &result, e, esize, v);
-	} else {
-	    u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	    Elem_set(zx, &result, e, esize, element1);
-	}
-    }
+    shift_kernel_z(zx, esize, op, false, &mask,
+		   &operand1, &operand2, &result);
     zx->z[Zdn] = result;
 }
 
@@ -3226,17 +5151,21 @@ perform_IOP_z_pred_wide2nd(svecxt_t *zx, int esize, bool wide2ndp, Iop op,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    enum signedness signedp = ((op == Iop_ASH_R) ? S64EXT : DONTCARE);
-
     int elements = zx->VL / esize;
     preg mask = zx->p[Pg];
     zreg operand1 = zx->z[Zdn];
     zreg operand2 = zx->z[Zm];
     zreg result = zreg_zeros;
+    if (shift_kernel_p(op)) {
+	shift_kernel_z(zx, esize, op, wide2ndp, &mask,
+		       &operand1, &operand2, &result);
+	zx->z[Zdn] = result;
+	return;
+    }
+    assert(!wide2ndp);
     for (int e = 0; e < elements; e++) {
-	int e2 = ((!wide2ndp) ? e : ((e * esize) / 64));
-	u64 element1 = Elem_get(zx, &operand1, e, esize, signedp);
-	u64 element2 = Elem_get(zx, &operand2, e2, esize, DONTCARE);
+	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
+	u64 element2 = Elem_get(zx, &operand2, e, esize, DONTCARE);
 	if (ElemP_get(zx, &mask, e, esize) == 1) {
 	    u64 v = calculate_iop(esize, op, element1, element2);
 	    Elem_set(zx, &result, e, esize, v);
@@ -3255,6 +5184,242 @@ perform_IOP_z_pred(svecxt_t *zx, int esize, Iop op,
     perform_IOP_z_pred_wide2nd(zx, esize, false, op, Zdn, Zm, Pg);
 }
 
+/* NEON KERNELS of saturating add/subtract (SQADD/UQADD/SQSUB/UQSUB)
+   and multiply-high (SMULH/UMULH) of a 128-bit segment. */
+
+static uint8x16_t
+qadd_kernel(int esize, bool sub_op, bool unsignedp,
+	    uint8x16_t x, uint8x16_t y)
+{
+    /*NEON*/
+    switch (esize) {
+    case 8: {
+	if (unsignedp) {
+	    return (sub_op ? vqsubq_u8(x, y) : vqaddq_u8(x, y));
+	} else {
+	    int8x16_t sx = vreinterpretq_s8_u8(x);
+	    int8x16_t sy = vreinterpretq_s8_u8(y);
+	    int8x16_t v = (sub_op ? vqsubq_s8(sx, sy) : vqaddq_s8(sx, sy));
+	    return vreinterpretq_u8_s8(v);
+	}
+    }
+    case 16: {
+	if (unsignedp) {
+	    uint16x8_t ux = vreinterpretq_u16_u8(x);
+	    uint16x8_t uy = vreinterpretq_u16_u8(y);
+	    uint16x8_t v = (sub_op ? vqsubq_u16(ux, uy) : vqaddq_u16(ux, uy));
+	    return vreinterpretq_u8_u16(v);
+	} else {
+	    int16x8_t sx = vreinterpretq_s16_u8(x);
+	    int16x8_t sy = vreinterpretq_s16_u8(y);
+	    int16x8_t v = (sub_op ? vqsubq_s16(sx, sy) : vqaddq_s16(sx, sy));
+	    return vreinterpretq_u8_s16(v);
+	}
+    }
+    case 32: {
+	if (unsignedp) {
+	    uint32x4_t ux = vreinterpretq_u32_u8(x);
+	    uint32x4_t uy = vreinterpretq_u32_u8(y);
+	    uint32x4_t v = (sub_op ? vqsubq_u32(ux, uy) : vqaddq_u32(ux, uy));
+	    return vreinterpretq_u8_u32(v);
+	} else {
+	    int32x4_t sx = vreinterpretq_s32_u8(x);
+	    int32x4_t sy = vreinterpretq_s32_u8(y);
+	    int32x4_t v = (sub_op ? vqsubq_s32(sx, sy) : vqaddq_s32(sx, sy));
+	    return vreinterpretq_u8_s32(v);
+	}
+    }
+    case 64: {
+	if (unsignedp) {
+	    uint64x2_t ux = vreinterpretq_u64_u8(x);
+	    uint64x2_t uy = vreinterpretq_u64_u8(y);
+	    uint64x2_t v = (sub_op ? vqsubq_u64(ux, uy) : vqaddq_u64(ux, uy));
+	    return vreinterpretq_u8_u64(v);
+	} else {
+	    int64x2_t sx = vreinterpretq_s64_u8(x);
+	    int64x2_t sy = vreinterpretq_s64_u8(y);
+	    int64x2_t v = (sub_op ? vqsubq_s64(sx, sy) : vqaddq_s64(sx, sy));
+	    return vreinterpretq_u8_s64(v);
+	}
+    }
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+/* Takes the high halves of the double-width products.  NEON has no
+   64-bit multiply, and 64-bit is done by 128-bit integers. */
+
+static u64
+mulh64(bool unsignedp, u64 x, u64 y)
+{
+    if (unsignedp) {
+	return (u64)(((u128)x * (u128)y) >> 64);
+    } else {
+	return (u64)(((s128)(s64)x * (s128)(s64)y) >> 64);
+    }
+}
+
+static uint8x16_t
+mulh_kernel(int esize, bool unsignedp, uint8x16_t x, uint8x16_t y)
+{
+    /*NEON*/
+    switch (esize) {
+    case 8: {
+	if (unsignedp) {
+	    uint16x8_t lo = vmull_u8(vget_low_u8(x), vget_low_u8(y));
+	    uint16x8_t hi = vmull_high_u8(x, y);
+	    return vuzp2q_u8(vreinterpretq_u8_u16(lo),
+			     vreinterpretq_u8_u16(hi));
+	} else {
+	    int8x16_t sx = vreinterpretq_s8_u8(x);
+	    int8x16_t sy = vreinterpretq_s8_u8(y);
+	    int16x8_t lo = vmull_s8(vget_low_s8(sx), vget_low_s8(sy));
+	    int16x8_t hi = vmull_high_s8(sx, sy);
+	    return vuzp2q_u8(vreinterpretq_u8_s16(lo),
+			     vreinterpretq_u8_s16(hi));
+	}
+    }
+    case 16: {
+	uint32x4_t lo;
+	uint32x4_t hi;
+	if (unsignedp) {
+	    uint16x8_t ux = vreinterpretq_u16_u8(x);
+	    uint16x8_t uy = vreinterpretq_u16_u8(y);
+	    lo = vmull_u16(vget_low_u16(ux), vget_low_u16(uy));
+	    hi = vmull_high_u16(ux, uy);
+	} else {
+	    int16x8_t sx = vreinterpretq_s16_u8(x);
+	    int16x8_t sy = vreinterpretq_s16_u8(y);
+	    lo = vreinterpretq_u32_s32(vmull_s16(vget_low_s16(sx),
+						 vget_low_s16(sy)));
+	    hi = vreinterpretq_u32_s32(vmull_high_s16(sx, sy));
+	}
+	uint16x8_t v = vuzp2q_u16(vreinterpretq_u16_u32(lo),
+				  vreinterpretq_u16_u32(hi));
+	return vreinterpretq_u8_u16(v);
+    }
+    case 32: {
+	uint64x2_t lo;
+	uint64x2_t hi;
+	if (unsignedp) {
+	    uint32x4_t ux = vreinterpretq_u32_u8(x);
+	    uint32x4_t uy = vreinterpretq_u32_u8(y);
+	    lo = vmull_u32(vget_low_u32(ux), vget_low_u32(uy));
+	    hi = vmull_high_u32(ux, uy);
+	} else {
+	    int32x4_t sx = vreinterpretq_s32_u8(x);
+	    int32x4_t sy = vreinterpretq_s32_u8(y);
+	    lo = vreinterpretq_u64_s64(vmull_s32(vget_low_s32(sx),
+						 vget_low_s32(sy)));
+	    hi = vreinterpretq_u64_s64(vmull_high_s32(sx, sy));
+	}
+	uint32x4_t v = vuzp2q_u32(vreinterpretq_u32_u64(lo),
+				  vreinterpretq_u32_u64(hi));
+	return vreinterpretq_u8_u32(v);
+    }
+    case 64: {
+	uint64x2_t ux = vreinterpretq_u64_u8(x);
+	uint64x2_t uy = vreinterpretq_u64_u8(y);
+	u64 v0 = mulh64(unsignedp, vgetq_lane_u64(ux, 0),
+			vgetq_lane_u64(uy, 0));
+	u64 v1 = mulh64(unsignedp, vgetq_lane_u64(ux, 1),
+			vgetq_lane_u64(uy, 1));
+	return vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(v0),
+						 vcreate_u64(v1)));
+    }
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+/* Zd := Zn +/- Zm (or Zd := Zn +/- imm), saturated.  The immediate is
+   unsigned and can exceed the signed range of the element, and then
+   it is added in steps of the largest signed value.  It is exact,
+   because once saturated, further steps go the same direction. */
+
+static void
+perform_QADD_z_imm(svecxt_t *zx, int esize, bool sub_op, bool unsignedp,
+		   bool z0imm1, int Zd, int Zn, int Zm, u64 imm)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(!(z0imm1 == false) || imm == 0);
+    assert(!(z0imm1 == true) || Zm == 99);
+
+    u64 smax = ((1ULL << (esize - 1)) - 1);
+    int steps = 0;
+    u64 rest = imm;
+    while (!unsignedp && rest > smax) {
+	rest -= smax;
+	steps++;
+    }
+    int segments = zx->VL / 128;
+    zreg operand1 = zx->z[Zn];
+    zreg operand2 = ((z0imm1 == false)
+		     ? zx->z[Zm] : Replicate_z(zx, esize, rest));
+    zreg result = zreg_zeros;
+    /*NEON*/
+    uint8x16_t step = Replicate_q(esize, smax);
+    for (int i = 0; i < segments; i++) {
+	uint8x16_t x = vld1q_u8(&operand1.b[16 * i]);
+	uint8x16_t y = vld1q_u8(&operand2.b[16 * i]);
+	for (int j = 0; j < steps; j++) {
+	    x = qadd_kernel(esize, sub_op, unsignedp, x, step);
+	}
+	uint8x16_t v = qadd_kernel(esize, sub_op, unsignedp, x, y);
+	vst1q_u8(&result.b[16 * i], v);
+    }
+    zx->z[Zd] = result;
+}
+
+static void
+perform_QADD_z(svecxt_t *zx, int esize, bool sub_op, bool unsignedp,
+	       int Zd, int Zn, int Zm)
+{
+    perform_QADD_z_imm(zx, esize, sub_op, unsignedp,
+		       false, Zd, Zn, Zm, 0);
+}
+
+static void
+perform_QADD_imm(svecxt_t *zx, int esize, bool sub_op, bool unsignedp,
+		 int Zdn, u64 imm)
+{
+    perform_QADD_z_imm(zx, esize, sub_op, unsignedp,
+		       true, Zdn, Zdn, 99, imm);
+}
+
+/* Zdn := (Zdn * Zm) >> esize, on the active elements. */
+
+static void
+perform_MULH(svecxt_t *zx, int esize, bool unsignedp,
+	     int Zdn, int Zm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    int lanes = 128 / esize;
+    preg mask = zx->p[Pg];
+    zreg operand1 = zx->z[Zdn];
+    zreg operand2 = zx->z[Zm];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	uint8x16_t x = vld1q_u8(&operand1.b[16 * i]);
+	uint8x16_t y = vld1q_u8(&operand2.b[16 * i]);
+	uint8x16_t v = mulh_kernel(esize, unsignedp, x, y);
+	uint8x16_t k = ElemP_lanes(zx, &mask, (lanes * i), esize);
+	vst1q_u8(&result.b[16 * i], vbslq_u8(k, v, x));
+    }
+    zx->z[Zdn] = result;
+}
+
 /* Reverses subelements inside an element. */
 
 static void
@@ -3311,54 +5476,82 @@ perform_LOP_p(svecxt_t *zx, int esize, bool setflags, Iop op,
     zx->p[Pd] = result;
 }
 
-static bool
-compare_f64(SVECmp op, int esize , u64 ux, u64 uy)
+/* NEON KERNELS of floating-point compares.  A kernel returns the lane
+   masks of a 128-bit segment.  The ordered compares are false on
+   NaNs, NE is true on NaNs, and UN is true exactly on NaNs.  LT/LE
+   are GT/GE with swapped operands.  ABSOLUTEP compares the absolute
+   values (FACxx). */
+
+static uint32x4_t
+fcmp_kernel_sf(SVECmp op, bool absolutep, float32x4_t x, float32x4_t y)
 {
-    switch (esize) {
-    case 32: {
-	float x = u64_as_float(ux);
-	float y = u64_as_float(uy);
-	switch (op) {
-	case Cmp_EQ: return (x == y);
-	case Cmp_NE: return (x != y);
-	case Cmp_GE: return isgreaterequal(x, y);
-	case Cmp_LT: return isless(x, y);
-	case Cmp_GT: return isgreater(x, y);
-	case Cmp_LE: return islessequal(x, y);
-	case Cmp_UN: return isunordered(x, y);
-	default:
-	    assert(op == Cmp_EQ || op == Cmp_NE
-		   || op == Cmp_GE || op == Cmp_LT
-		   || op == Cmp_GT || op == Cmp_LE
-		   || op == Cmp_UN);
-	    abort();
+    bool swapp = (op == Cmp_LT || op == Cmp_LE);
+    float32x4_t a = (swapp ? y : x);
+    float32x4_t b = (swapp ? x : y);
+    /*NEON*/
+    switch (op) {
+    case Cmp_GE: case Cmp_LE:
+	return (absolutep ? vcageq_f32(a, b) : vcgeq_f32(a, b));
+    case Cmp_GT: case Cmp_LT:
+	return (absolutep ? vcagtq_f32(a, b) : vcgtq_f32(a, b));
+    case Cmp_EQ: case Cmp_NE: {
+	if (absolutep) {
+	    a = vabsq_f32(a);
+	    b = vabsq_f32(b);
 	}
+	uint32x4_t m = vceqq_f32(a, b);
+	return ((op == Cmp_NE) ? vmvnq_u32(m) : m);
     }
-    case 64: {
-	double x = u64_as_double(ux);
-	double y = u64_as_double(uy);
-	switch (op) {
-	case Cmp_EQ: return (x == y);
-	case Cmp_NE: return (x != y);
-	case Cmp_GE: return isgreaterequal(x, y);
-	case Cmp_LT: return isless(x, y);
-	case Cmp_GT: return isgreater(x, y);
-	case Cmp_LE: return islessequal(x, y);
-	case Cmp_UN: return isunordered(x, y);
-	default:
-	    assert(op == Cmp_EQ || op == Cmp_NE
-		   || op == Cmp_GE || op == Cmp_LT
-		   || op == Cmp_GT || op == Cmp_LE
-		   || op == Cmp_UN);
-	    abort();
+    case Cmp_UN: {
+	uint32x4_t ordered = vandq_u32(vceqq_f32(a, a), vceqq_f32(b, b));
+	return vmvnq_u32(ordered);
+    }
+    default:
+	assert(op == Cmp_EQ || op == Cmp_NE
+	       || op == Cmp_GE || op == Cmp_LT
+	       || op == Cmp_GT || op == Cmp_LE
+	       || op == Cmp_UN);
+	abort();
+    }
+}
+
+static uint64x2_t
+fcmp_kernel_df(SVECmp op, bool absolutep, float64x2_t x, float64x2_t y)
+{
+    bool swapp = (op == Cmp_LT || op == Cmp_LE);
+    float64x2_t a = (swapp ? y : x);
+    float64x2_t b = (swapp ? x : y);
+    /*NEON*/
+    switch (op) {
+    case Cmp_GE: case Cmp_LE:
+	return (absolutep ? vcageq_f64(a, b) : vcgeq_f64(a, b));
+    case Cmp_GT: case Cmp_LT:
+	return (absolutep ? vcagtq_f64(a, b) : vcgtq_f64(a, b));
+    case Cmp_EQ: case Cmp_NE: {
+	if (absolutep) {
+	    a = vabsq_f64(a);
+	    b = vabsq_f64(b);
 	}
+	uint64x2_t m = vceqq_f64(a, b);
+	return ((op == Cmp_NE)
+		? vreinterpretq_u64_u8(vmvnq_u8(vreinterpretq_u8_u64(m))) : m);
+    }
+    case Cmp_UN: {
+	uint64x2_t ordered = vandq_u64(vceqq_f64(a, a), vceqq_f64(b, b));
+	return vreinterpretq_u64_u8(vmvnq_u8(vreinterpretq_u8_u64(ordered)));
     }
     default:
-	assert(esize == 32 || esize == 64);
+	assert(op == Cmp_EQ || op == Cmp_NE
+	       || op == Cmp_GE || op == Cmp_LT
+	       || op == Cmp_GT || op == Cmp_LE
+	       || op == Cmp_UN);
 	abort();
     }
 }
 
+/* Compares the elements of Zn with Zm, or with zeros when Zm is 99.
+   Predicates are set in bulk from the lane masks. */
+
 static void
 perform_FCMP_z(svecxt_t *zx, int esize, SVECmp op, bool absolutep,
 	       int Pd, int Zn, int Zm, int Pg)
@@ -3367,23 +5560,38 @@ perform_FCMP_z(svecxt_t *zx, int esize, SVECmp op, bool absolutep,
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    assert(esize == 32 || esize == 64);
-    int elements = zx->VL / esize;
+    assert(esize == 16 || esize == 32 || esize == 64);
+    int segments = zx->VL / 128;
     preg mask = zx->p[Pg];
     zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
+    zreg operand2 = ((Zm != 99) ? zx->z[Zm] : zreg_zeros);
     preg result = preg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	u64 element2 = Elem_get(zx, &operand2, e, esize, DONTCARE);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 e1 = (absolutep ? FPAbs(esize, element1) : element1);
-	    u64 e2 = (absolutep ? FPAbs(esize, element2) : element2);
-	    bool r = compare_f64(op, esize, e1, e2);
-	    ElemP_set(zx, &result, e, esize, r);
+    for (int i = 0; i < segments; i++) {
+	uint8x16_t m;
+	/*NEON*/
+	if (esize == 16) {
+	    /* (Widening to single-precision is exact). */
+	    float16x8_t x = vreinterpretq_f16_u16(vld1q_u16(&operand1.h[8 * i]));
+	    float16x8_t y = vreinterpretq_f16_u16(vld1q_u16(&operand2.h[8 * i]));
+	    uint32x4_t lo = fcmp_kernel_sf(op, absolutep,
+					   vcvt_f32_f16(vget_low_f16(x)),
+					   vcvt_f32_f16(vget_low_f16(y)));
+	    uint32x4_t hi = fcmp_kernel_sf(op, absolutep,
+					   vcvt_high_f32_f16(x),
+					   vcvt_high_f32_f16(y));
+	    m = vreinterpretq_u8_u16(vmovn_high_u32(vmovn_u32(lo), hi));
+	} else if (esize == 32) {
+	    float32x4_t x = vreinterpretq_f32_u32(vld1q_u32(&operand1.w[4 * i]));
+	    float32x4_t y = vreinterpretq_f32_u32(vld1q_u32(&operand2.w[4 * i]));
+	    m = vreinterpretq_u8_u32(fcmp_kernel_sf(op, absolutep, x, y));
 	} else {
-	    ElemP_set(zx, &result, e, esize, 0);
+	    float64x2_t x = vreinterpretq_f64_u64(vld1q_u64(&operand1.x[2 * i]));
+	    float64x2_t y = vreinterpretq_f64_u64(vld1q_u64(&operand2.x[2 * i]));
+	    m = vreinterpretq_u8_u64(fcmp_kernel_df(op, absolutep, x, y));
 	}
+	uint8x16_t g = vandq_u8(ElemP_lanes(zx, &mask, (i * 128 / esize), esize),
+				ElemP_ones(esize));
+	vst1q_u8((u8 *)&result.k[16 * i], vandq_u8(m, g));
     }
     zx->p[Pd] = result;
 }
@@ -3392,26 +5600,8 @@ static void
 perform_FCMP_zero(svecxt_t *zx, int esize, SVECmp op, bool absolutep,
 		  int Pd, int Zn, int Pg)
 {
-    assert(zx != 0 && zx->ux != 0);
-    /*mcontext_t *ux = zx->ux;*/
-    CheckSVEEnabled();
-
     assert(absolutep == false);
-    assert(esize == 32 || esize == 64);
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg operand1 = zx->z[Zn];
-    preg result = preg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    bool r = compare_f64(op, esize, element1, 0ULL);
-	    ElemP_set(zx, &result, e, esize, r);
-	} else {
-	    ElemP_set(zx, &result, e, esize, 0);
-	}
-    }
-    zx->p[Pd] = result;
+    perform_FCMP_z(zx, esize, op, absolutep, Pd, Zn, 99, Pg);
 }
 
 static void
@@ -3428,6 +5618,16 @@ perform_FOP_z(svecxt_t *zx, int esize, Fop op, bool predicatedp,
     zreg operand1 = (predicatedp ? zx->z[Zd] : zx->z[Zn]);
     zreg operand2 = zx->z[Zm];
     zreg result = zreg_zeros;
+    if (fop_kernel_p(esize, op)) {
+	fop_kernel_z(zx, esize, op, &mask, &operand1, &operand2, &result);
+	zx->z[Zd] = result;
+	return;
+    }
+    if (cvt_kernel_p(esize, op)) {
+	cvt_kernel_z(zx, esize, op, &mask, &operand1, &operand2, &result);
+	zx->z[Zd] = result;
+	return;
+    }
     for (int e = 0; e < elements; e++) {
 	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
 	u64 element2 = Elem_get(zx, &operand2, e, esize, DONTCARE);
@@ -3454,170 +5654,1381 @@ perform_FOP_imm(svecxt_t *zx, int esize, Fop op, bool predicatedp,
     preg mask = (predicatedp ? zx->p[Pg] : preg_all_ones);
     zreg operand1 = zx->z[Zdn];
     zreg result = zreg_zeros;
+    if (fop_kernel_p(esize, op)) {
+	zreg operand2 = Replicate_z(zx, esize, imm);
+	fop_kernel_z(zx, esize, op, &mask, &operand1, &operand2, &result);
+	zx->z[Zdn] = result;
+	return;
+    }
     for (int e = 0; e < elements; e++) {
 	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
 	if (ElemP_get(zx, &mask, e, esize) == 1) {
 	    u64 v = calculate_fop(esize, op, element1, imm);
 	    Elem_set(zx, &result, e, esize, v);
 	} else {
-	    Elem_set(zx, &result, e, esize, element1);
+	    Elem_set(zx, &result, e, esize, element1);
+	}
+    }
+    zx->z[Zdn] = result;
+}
+
+/* Zd := Za + sub_op(Zn * Zm) */
+
+static void
+perform_IFMA(svecxt_t *zx, int esize, int Zd,
+	     int Za, bool sub_op, int Zn, int Zm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    preg mask = zx->p[Pg];
+    zreg oldvalue = zx->z[Zd];
+    zreg operand1 = zx->z[Zn];
+    zreg operand2 = zx->z[Zm];
+    zreg operand3 = zx->z[Za];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	switch (esize) {
+	case 8: {
+	    int e = (16 * i);
+	    uint8x16_t a = vld1q_u8(&operand3.b[e]);
+	    uint8x16_t n = vld1q_u8(&operand1.b[e]);
+	    uint8x16_t m = vld1q_u8(&operand2.b[e]);
+	    uint8x16_t v = (sub_op ? vmlsq_u8(a, n, m) : vmlaq_u8(a, n, m));
+	    uint8x16_t k = ElemP_lanes8(zx, &mask, e);
+	    vst1q_u8(&result.b[e], vbslq_u8(k, v, vld1q_u8(&oldvalue.b[e])));
+	    break;
+	}
+	case 16: {
+	    int e = (8 * i);
+	    uint16x8_t a = vld1q_u16(&operand3.h[e]);
+	    uint16x8_t n = vld1q_u16(&operand1.h[e]);
+	    uint16x8_t m = vld1q_u16(&operand2.h[e]);
+	    uint16x8_t v = (sub_op ? vmlsq_u16(a, n, m) : vmlaq_u16(a, n, m));
+	    uint16x8_t k = ElemP_lanes16(zx, &mask, e);
+	    vst1q_u16(&result.h[e], vbslq_u16(k, v, vld1q_u16(&oldvalue.h[e])));
+	    break;
+	}
+	case 32: {
+	    int e = (4 * i);
+	    uint32x4_t a = vld1q_u32(&operand3.w[e]);
+	    uint32x4_t n = vld1q_u32(&operand1.w[e]);
+	    uint32x4_t m = vld1q_u32(&operand2.w[e]);
+	    uint32x4_t v = (sub_op ? vmlsq_u32(a, n, m) : vmlaq_u32(a, n, m));
+	    uint32x4_t k = ElemP_lanes32(zx, &mask, e);
+	    vst1q_u32(&result.w[e], vbslq_u32(k, v, vld1q_u32(&oldvalue.w[e])));
+	    break;
+	}
+	case 64: {
+	    /* NEON has no 64-bit multiply. */
+	    for (int e = (2 * i); e < (2 * i + 2); e++) {
+		u64 element1 = operand1.x[e];
+		u64 element2 = operand2.x[e];
+		u64 element3 = operand3.x[e];
+		if (ElemP_get(zx, &mask, e, esize) == 1) {
+		    if (sub_op) {
+			result.x[e] = (element3 - (element1 * element2));
+		    } else {
+			result.x[e] = (element3 + (element1 * element2));
+		    }
+		} else {
+		    result.x[e] = oldvalue.x[e];
+		}
+	    }
+	    break;
+	}
+	default:
+	    assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+    zx->z[Zd] = result;
+}
+
+/* Multiply-adds four half-precision lanes.  Half-precision is
+   computed in double-precision and narrowed by round-to-odd then
+   round-to-nearest, so the result is rounded once.  A product of two
+   half-precision values is exact in double-precision, and so is the
+   sum whenever it affects the rounding in half-precision. */
+
+static float16x4_t
+fmla_hf4(float16x4_t a, float16x4_t n, float16x4_t m, bool accumulate)
+{
+    /*NEON*/
+    float32x4_t n32 = vcvt_f32_f16(n);
+    float32x4_t m32 = vcvt_f32_f16(m);
+    float64x2_t nlo = vcvt_f64_f32(vget_low_f32(n32));
+    float64x2_t nhi = vcvt_high_f64_f32(n32);
+    float64x2_t mlo = vcvt_f64_f32(vget_low_f32(m32));
+    float64x2_t mhi = vcvt_high_f64_f32(m32);
+    float64x2_t lo;
+    float64x2_t hi;
+    if (accumulate) {
+	float32x4_t a32 = vcvt_f32_f16(a);
+	lo = vfmaq_f64(vcvt_f64_f32(vget_low_f32(a32)), nlo, mlo);
+	hi = vfmaq_f64(vcvt_high_f64_f32(a32), nhi, mhi);
+    } else {
+	lo = vmulq_f64(nlo, mlo);
+	hi = vmulq_f64(nhi, mhi);
+    }
+    float32x4_t r32 = vcvtx_high_f32_f64(vcvtx_f32_f64(lo), hi);
+    return vcvt_f16_f32(r32);
+}
+
+static uint16x8_t __attribute__ ((target ("arch=armv8.2-a+fp16")))
+ffma_kernel_hf_fp16(uint16x8_t a, uint16x8_t n, uint16x8_t m)
+{
+    /*NEON*/
+    float16x8_t v = vfmaq_f16(vreinterpretq_f16_u16(a),
+			      vreinterpretq_f16_u16(n),
+			      vreinterpretq_f16_u16(m));
+    return vreinterpretq_u16_f16(v);
+}
+
+/* Multiply-adds eight half-precision lanes, A + N * M. */
+
+static uint16x8_t
+ffma_hf8(uint16x8_t a, uint16x8_t n, uint16x8_t m)
+{
+    if (fp16_kernel == KERNEL_FP16) {
+	return ffma_kernel_hf_fp16(a, n, m);
+    }
+    /*NEON*/
+    float16x8_t af = vreinterpretq_f16_u16(a);
+    float16x8_t nf = vreinterpretq_f16_u16(n);
+    float16x8_t mf = vreinterpretq_f16_u16(m);
+    float16x4_t lo = fmla_hf4(vget_low_f16(af), vget_low_f16(nf),
+			      vget_low_f16(mf), true);
+    float16x4_t hi = fmla_hf4(vget_high_f16(af), vget_high_f16(nf),
+			      vget_high_f16(mf), true);
+    return vreinterpretq_u16_f16(vcombine_f16(lo, hi));
+}
+
+/* Zd := (op3_neg Za) + ((op1_neg Zn) * Zm) */
+
+static void
+perform_FFMA(svecxt_t *zx, int esize, int Zd,
+	     bool op3_neg, int Za, bool op1_neg, int Zn, int Zm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(esize == 16 || esize == 32 || esize == 64);
+    int segments = zx->VL / 128;
+    preg mask = zx->p[Pg];
+    zreg oldvalue = zx->z[Zd];
+    zreg operand1 = zx->z[Zn];
+    zreg operand2 = zx->z[Zm];
+    zreg operand3 = zx->z[Za];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	if (esize == 16) {
+	    int e = (8 * i);
+	    uint16x8_t n = vld1q_u16(&operand1.h[e]);
+	    uint16x8_t m = vld1q_u16(&operand2.h[e]);
+	    uint16x8_t a = vld1q_u16(&operand3.h[e]);
+	    if (op1_neg) {n = veorq_u16(n, vdupq_n_u16(0x8000));}
+	    if (op3_neg) {a = veorq_u16(a, vdupq_n_u16(0x8000));}
+	    uint16x8_t v = ffma_hf8(a, n, m);
+	    uint16x8_t k = ElemP_lanes16(zx, &mask, e);
+	    vst1q_u16(&result.h[e], vbslq_u16(k, v, vld1q_u16(&oldvalue.h[e])));
+	} else if (esize == 32) {
+	    int e = (4 * i);
+	    float32x4_t n = vreinterpretq_f32_u32(vld1q_u32(&operand1.w[e]));
+	    float32x4_t m = vreinterpretq_f32_u32(vld1q_u32(&operand2.w[e]));
+	    float32x4_t a = vreinterpretq_f32_u32(vld1q_u32(&operand3.w[e]));
+	    if (op1_neg) {n = vnegq_f32(n);}
+	    if (op3_neg) {a = vnegq_f32(a);}
+	    uint32x4_t v = vreinterpretq_u32_f32(vfmaq_f32(a, n, m));
+	    uint32x4_t k = ElemP_lanes32(zx, &mask, e);
+	    vst1q_u32(&result.w[e], vbslq_u32(k, v, vld1q_u32(&oldvalue.w[e])));
+	} else {
+	    int e = (2 * i);
+	    float64x2_t n = vreinterpretq_f64_u64(vld1q_u64(&operand1.x[e]));
+	    float64x2_t m = vreinterpretq_f64_u64(vld1q_u64(&operand2.x[e]));
+	    float64x2_t a = vreinterpretq_f64_u64(vld1q_u64(&operand3.x[e]));
+	    if (op1_neg) {n = vnegq_f64(n);}
+	    if (op3_neg) {a = vnegq_f64(a);}
+	    uint64x2_t v = vreinterpretq_u64_f64(vfmaq_f64(a, n, m));
+	    uint64x2_t k = ElemP_lanes64(zx, &mask, e);
+	    vst1q_u64(&result.x[e], vbslq_u64(k, v, vld1q_u64(&oldvalue.x[e])));
+	}
+    }
+    zx->z[Zd] = result;
+}
+
+/* Indexed FMLA/FMLS/FMUL.  The element at INDEX of each 128-bit
+   segment of Zm multiplies the elements of Zn in the segment.  It is
+   Zd := Zd + ((op1_neg Zn) * Zm[index]) when ACCUMULATE, or Zd := Zn *
+   Zm[index] otherwise.  It is unpredicated. */
+
+static void
+perform_FMLA_indexed(svecxt_t *zx, int esize, bool accumulate, bool op1_neg,
+		     int Zd, int Zn, int Zm, int index)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(index >= 0 && index < (128 / esize));
+    int segments = zx->VL / 128;
+    zreg *operand1 = &zx->z[Zn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg *operand3 = &zx->z[Zd];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	switch (esize) {
+	case 16: {
+	    int e = (8 * i);
+	    uint16x8_t n = vld1q_u16(&operand1->h[e]);
+	    uint16x8_t m = vld1q_dup_u16(&operand2->h[e + index]);
+	    uint16x8_t a = vld1q_u16(&operand3->h[e]);
+	    if (op1_neg) {n = veorq_u16(n, vdupq_n_u16(0x8000U));}
+	    float16x8_t nf = vreinterpretq_f16_u16(n);
+	    float16x8_t mf = vreinterpretq_f16_u16(m);
+	    float16x8_t af = vreinterpretq_f16_u16(a);
+	    float16x4_t lo = fmla_hf4(vget_low_f16(af), vget_low_f16(nf),
+				      vget_low_f16(mf), accumulate);
+	    float16x4_t hi = fmla_hf4(vget_high_f16(af), vget_high_f16(nf),
+				      vget_high_f16(mf), accumulate);
+	    uint16x8_t v = vreinterpretq_u16_f16(vcombine_f16(lo, hi));
+	    vst1q_u16(&result.h[e], v);
+	    break;
+	}
+	case 32: {
+	    int e = (4 * i);
+	    float32x4_t n = vreinterpretq_f32_u32(vld1q_u32(&operand1->w[e]));
+	    uint32x4_t m0 = vld1q_dup_u32(&operand2->w[e + index]);
+	    float32x4_t m = vreinterpretq_f32_u32(m0);
+	    float32x4_t a = vreinterpretq_f32_u32(vld1q_u32(&operand3->w[e]));
+	    if (op1_neg) {n = vnegq_f32(n);}
+	    float32x4_t v = (accumulate ? vfmaq_f32(a, n, m) : vmulq_f32(n, m));
+	    vst1q_u32(&result.w[e], vreinterpretq_u32_f32(v));
+	    break;
+	}
+	case 64: {
+	    int e = (2 * i);
+	    float64x2_t n = vreinterpretq_f64_u64(vld1q_u64(&operand1->x[e]));
+	    uint64x2_t m0 = vld1q_dup_u64(&operand2->x[e + index]);
+	    float64x2_t m = vreinterpretq_f64_u64(m0);
+	    float64x2_t a = vreinterpretq_f64_u64(vld1q_u64(&operand3->x[e]));
+	    if (op1_neg) {n = vnegq_f64(n);}
+	    float64x2_t v = (accumulate ? vfmaq_f64(a, n, m) : vmulq_f64(n, m));
+	    vst1q_u64(&result.x[e], vreinterpretq_u64_f64(v));
+	    break;
+	}
+	default:
+	    assert(esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+    zx->z[Zd] = result;
+}
+
+/* Coefficients of FEXPA.  They are the fractions of 2^(i/32) for
+   half-precision, and of 2^(i/64) for single and double-precision
+   (FPExpCoefficient in the definition). */
+
+static const u16 fexpa_coeff16[32] = {
+    0x0000, 0x0016, 0x002d, 0x0045, 0x005d, 0x0075, 0x008e, 0x00a8,
+    0x00c2, 0x00dc, 0x00f8, 0x0114, 0x0130, 0x014d, 0x016b, 0x0189,
+    0x01a8, 0x01c8, 0x01e8, 0x0209, 0x022b, 0x024e, 0x0271, 0x0295,
+    0x02ba, 0x02e0, 0x0306, 0x032e, 0x0356, 0x037f, 0x03a9, 0x03d4,
+};
+static const u32 fexpa_coeff32[64] = {
+    0x000000, 0x0164d2, 0x02cd87, 0x043a29, 0x05aac3, 0x071f62,
+    0x08980f, 0x0a14d5, 0x0b95c2, 0x0d1adf, 0x0ea43a, 0x1031dc,
+    0x11c3d3, 0x135a2b, 0x14f4f0, 0x16942d, 0x1837f0, 0x19e046,
+    0x1b8d3a, 0x1d3eda, 0x1ef532, 0x20b051, 0x227043, 0x243516,
+    0x25fed7, 0x27cd94, 0x29a15b, 0x2b7a3a, 0x2d583f, 0x2f3b79,
+    0x3123f6, 0x3311c4, 0x3504f3, 0x36fd92, 0x38fbaf, 0x3aff5b,
+    0x3d08a4, 0x3f179a, 0x412c4d, 0x4346cd, 0x45672a, 0x478d75,
+    0x49b9be, 0x4bec15, 0x4e248c, 0x506334, 0x52a81e, 0x54f35b,
+    0x5744fd, 0x599d16, 0x5bfbb8, 0x5e60f5, 0x60ccdf, 0x633f89,
+    0x65b907, 0x68396a, 0x6ac0c7, 0x6d4f30, 0x6fe4ba, 0x728177,
+    0x75257d, 0x77d0df, 0x7a83b3, 0x7d3e0c,
+};
+static const u64 fexpa_coeff64[64] = {
+    0x0000000000000ULL, 0x02c9a3e778061ULL, 0x059b0d3158574ULL,
+    0x0874518759bc8ULL, 0x0b5586cf9890fULL, 0x0e3ec32d3d1a2ULL,
+    0x11301d0125b51ULL, 0x1429aaea92de0ULL, 0x172b83c7d517bULL,
+    0x1a35beb6fcb75ULL, 0x1d4873168b9aaULL, 0x2063b88628cd6ULL,
+    0x2387a6e756238ULL, 0x26b4565e27cddULL, 0x29e9df51fdee1ULL,
+    0x2d285a6e4030bULL, 0x306fe0a31b715ULL, 0x33c08b26416ffULL,
+    0x371a7373aa9cbULL, 0x3a7db34e59ff7ULL, 0x3dea64c123422ULL,
+    0x4160a21f72e2aULL, 0x44e086061892dULL, 0x486a2b5c13cd0ULL,
+    0x4bfdad5362a27ULL, 0x4f9b2769d2ca7ULL, 0x5342b569d4f82ULL,
+    0x56f4736b527daULL, 0x5ab07dd485429ULL, 0x5e76f15ad2148ULL,
+    0x6247eb03a5585ULL, 0x6623882552225ULL, 0x6a09e667f3bcdULL,
+    0x6dfb23c651a2fULL, 0x71f75e8ec5f74ULL, 0x75feb564267c9ULL,
+    0x7a11473eb0187ULL, 0x7e2f336cf4e62ULL, 0x82589994cce13ULL,
+    0x868d99b4492edULL, 0x8ace5422aa0dbULL, 0x8f1ae99157736ULL,
+    0x93737b0cdc5e5ULL, 0x97d829fde4e50ULL, 0x9c49182a3f090ULL,
+    0xa0c667b5de565ULL, 0xa5503b23e255dULL, 0xa9e6b5579fdbfULL,
+    0xae89f995ad3adULL, 0xb33a2b84f15fbULL, 0xb7f76f2fb5e47ULL,
+    0xbcc1e904bc1d2ULL, 0xc199bdd85529cULL, 0xc67f12e57d14bULL,
+    0xcb720dcef9069ULL, 0xd072d4a07897cULL, 0xd5818dcfba487ULL,
+    0xda9e603db3285ULL, 0xdfc97337b9b5fULL, 0xe502ee78b3ff6ULL,
+    0xea4afa2a490daULL, 0xefa1bee615a27ULL, 0xf50765b6e4540ULL,
+    0xfa7c1819e90d8ULL,
+};
+
+/* Coefficients of FTMAD.  The first eight are of sin and the last
+   eight are of cos (FPTrigMAddCoefficient in the definition). */
+
+static const u16 ftmad_coeff16[16] = {
+    0x3c00, 0xb155, 0x2030, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x3c00, 0xb800, 0x293a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+};
+static const u32 ftmad_coeff32[16] = {
+    0x3f800000, 0xbe2aaaab, 0x3c088886, 0xb95008b9,
+    0x36369d6d, 0x00000000, 0x00000000, 0x00000000,
+    0x3f800000, 0xbf000000, 0x3d2aaaa6, 0xbab60705,
+    0x37cd37cc, 0x00000000, 0x00000000, 0x00000000,
+};
+static const u64 ftmad_coeff64[16] = {
+    0x3ff0000000000000ULL, 0xbfc5555555555543ULL,
+    0x3f8111111110f30cULL, 0xbf2a01a019b92fc6ULL,
+    0x3ec71de351f3d22bULL, 0xbe5ae5e2b60f7b91ULL,
+    0x3de5d8408868552fULL, 0x0000000000000000ULL,
+    0x3ff0000000000000ULL, 0xbfe0000000000000ULL,
+    0x3fa5555555555536ULL, 0xbf56c16c16c13a0bULL,
+    0x3efa01a019b1e8d8ULL, 0xbe927e4f7282f468ULL,
+    0x3e21ee96d2641b13ULL, 0xbda8f76380fbb401ULL,
+};
+
+/* FEXPA.  The exponent field is moved in place from the operand, and
+   the fraction is looked up in the table.  Half-precision looks up
+   by TBL with the byte indices of the entries. */
+
+static void
+perform_FEXPA(svecxt_t *zx, int esize, int Zd, int Zn)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    zreg *operand = &zx->z[Zn];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    const u8 *t16 = (const u8 *)fexpa_coeff16;
+    uint8x16x4_t table16 = {{vld1q_u8(&t16[0]), vld1q_u8(&t16[16]),
+			     vld1q_u8(&t16[32]), vld1q_u8(&t16[48])}};
+    for (int i = 0; i < segments; i++) {
+	switch (esize) {
+	case 16: {
+	    int e = (8 * i);
+	    uint16x8_t op = vld1q_u16(&operand->h[e]);
+	    uint16x8_t x = vshlq_n_u16(vandq_u16(op, vdupq_n_u16(0x3e0)), 5);
+	    uint16x8_t b = vshlq_n_u16(vandq_u16(op, vdupq_n_u16(0x1f)), 1);
+	    uint16x8_t bb = vsliq_n_u16(b, vaddq_u16(b, vdupq_n_u16(1)), 8);
+	    uint8x16_t c = vqtbl4q_u8(table16, vreinterpretq_u8_u16(bb));
+	    vst1q_u16(&result.h[e], vorrq_u16(x, vreinterpretq_u16_u8(c)));
+	    break;
+	}
+	case 32: {
+	    int e = (4 * i);
+	    uint32x4_t op = vld1q_u32(&operand->w[e]);
+	    uint32x4_t x = vshlq_n_u32(vandq_u32(op, vdupq_n_u32(0x3fc0)), 17);
+	    u32 c[4];
+	    for (int j = 0; j < 4; j++) {
+		c[j] = fexpa_coeff32[operand->w[e + j] & 0x3f];
+	    }
+	    vst1q_u32(&result.w[e], vorrq_u32(x, vld1q_u32(c)));
+	    break;
+	}
+	case 64: {
+	    int e = (2 * i);
+	    uint64x2_t op = vld1q_u64(&operand->x[e]);
+	    uint64x2_t x = vshlq_n_u64(vandq_u64(op, vdupq_n_u64(0x1ffc0)), 46);
+	    u64 c[2];
+	    for (int j = 0; j < 2; j++) {
+		c[j] = fexpa_coeff64[operand->x[e + j] & 0x3f];
+	    }
+	    vst1q_u64(&result.x[e], vorrq_u64(x, vld1q_u64(c)));
+	    break;
+	}
+	default:
+	    assert(esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+    zx->z[Zd] = result;
+}
+
+/* FTSMUL.  It squares Zn, and replaces the sign with the bit-0 of Zm,
+   unless the square is a NaN. */
+
+static void
+perform_FTSMUL(svecxt_t *zx, int esize, int Zd, int Zn, int Zm)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    zreg *operand1 = &zx->z[Zn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	switch (esize) {
+	case 16: {
+	    int e = (8 * i);
+	    float16x8_t n = vreinterpretq_f16_u16(vld1q_u16(&operand1->h[e]));
+	    uint16x8_t m = vld1q_u16(&operand2->h[e]);
+	    float16x4_t z = vreinterpret_f16_u16(vdup_n_u16(0));
+	    float16x4_t lo = fmla_hf4(z, vget_low_f16(n), vget_low_f16(n),
+				      false);
+	    float16x4_t hi = fmla_hf4(z, vget_high_f16(n), vget_high_f16(n),
+				      false);
+	    uint16x8_t v = vreinterpretq_u16_f16(vcombine_f16(lo, hi));
+	    uint16x8_t num = vcleq_u16(vandq_u16(v, vdupq_n_u16(0x7fff)),
+				       vdupq_n_u16(0x7c00));
+	    uint16x8_t s = vshlq_n_u16(m, 15);
+	    uint16x8_t r = vbslq_u16(vdupq_n_u16(0x8000), s, v);
+	    vst1q_u16(&result.h[e], vbslq_u16(num, r, v));
+	    break;
+	}
+	case 32: {
+	    int e = (4 * i);
+	    float32x4_t n = vreinterpretq_f32_u32(vld1q_u32(&operand1->w[e]));
+	    uint32x4_t m = vld1q_u32(&operand2->w[e]);
+	    float32x4_t v0 = vmulq_f32(n, n);
+	    uint32x4_t v = vreinterpretq_u32_f32(v0);
+	    uint32x4_t num = vceqq_f32(v0, v0);
+	    uint32x4_t s = vshlq_n_u32(m, 31);
+	    uint32x4_t r = vbslq_u32(vdupq_n_u32(0x80000000U), s, v);
+	    vst1q_u32(&result.w[e], vbslq_u32(num, r, v));
+	    break;
+	}
+	case 64: {
+	    int e = (2 * i);
+	    float64x2_t n = vreinterpretq_f64_u64(vld1q_u64(&operand1->x[e]));
+	    uint64x2_t m = vld1q_u64(&operand2->x[e]);
+	    float64x2_t v0 = vmulq_f64(n, n);
+	    uint64x2_t v = vreinterpretq_u64_f64(v0);
+	    uint64x2_t num = vceqq_f64(v0, v0);
+	    uint64x2_t s = vshlq_n_u64(m, 63);
+	    uint64x2_t r = vbslq_u64(vdupq_n_u64(0x8000000000000000ULL), s, v);
+	    vst1q_u64(&result.x[e], vbslq_u64(num, r, v));
+	    break;
+	}
+	default:
+	    assert(esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+    zx->z[Zd] = result;
+}
+
+/* FTSSEL.  It selects one when the bit-0 of Zm is set or Zn otherwise,
+   and flips the sign by the bit-1 of Zm. */
+
+static void
+perform_FTSSEL(svecxt_t *zx, int esize, int Zd, int Zn, int Zm)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    zreg *operand1 = &zx->z[Zn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	switch (esize) {
+	case 16: {
+	    int e = (8 * i);
+	    uint16x8_t n = vld1q_u16(&operand1->h[e]);
+	    uint16x8_t m = vld1q_u16(&operand2->h[e]);
+	    uint16x8_t one = vdupq_n_u16(0x3c00);
+	    uint16x8_t v = vbslq_u16(vtstq_u16(m, vdupq_n_u16(1)), one, n);
+	    uint16x8_t s = vshlq_n_u16(vshrq_n_u16(m, 1), 15);
+	    vst1q_u16(&result.h[e], veorq_u16(v, s));
+	    break;
+	}
+	case 32: {
+	    int e = (4 * i);
+	    uint32x4_t n = vld1q_u32(&operand1->w[e]);
+	    uint32x4_t m = vld1q_u32(&operand2->w[e]);
+	    uint32x4_t one = vdupq_n_u32(0x3f800000U);
+	    uint32x4_t v = vbslq_u32(vtstq_u32(m, vdupq_n_u32(1)), one, n);
+	    uint32x4_t s = vshlq_n_u32(vshrq_n_u32(m, 1), 31);
+	    vst1q_u32(&result.w[e], veorq_u32(v, s));
+	    break;
+	}
+	case 64: {
+	    int e = (2 * i);
+	    uint64x2_t n = vld1q_u64(&operand1->x[e]);
+	    uint64x2_t m = vld1q_u64(&operand2->x[e]);
+	    uint64x2_t one = vdupq_n_u64(0x3ff0000000000000ULL);
+	    uint64x2_t v = vbslq_u64(vtstq_u64(m, vdupq_n_u64(1)), one, n);
+	    uint64x2_t s = vshlq_n_u64(vshrq_n_u64(m, 1), 63);
+	    vst1q_u64(&result.x[e], veorq_u64(v, s));
+	    break;
+	}
+	default:
+	    assert(esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+    zx->z[Zd] = result;
+}
+
+/* FTMAD.  It is Zdn := coeff + Zdn * abs(Zm), where the coefficient
+   is selected by the immediate and the sign of Zm. */
+
+static void
+perform_FTMAD(svecxt_t *zx, int esize, int Zdn, int Zm, int imm)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(imm >= 0 && imm < 8);
+    int segments = zx->VL / 128;
+    zreg *operand1 = &zx->z[Zdn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	switch (esize) {
+	case 16: {
+	    int e = (8 * i);
+	    uint16x8_t n = vld1q_u16(&operand1->h[e]);
+	    uint16x8_t m = vld1q_u16(&operand2->h[e]);
+	    uint16x8_t sign = vdupq_n_u16(0x8000);
+	    uint16x8_t c = vbslq_u16(vtstq_u16(m, sign),
+				     vdupq_n_u16(ftmad_coeff16[imm + 8]),
+				     vdupq_n_u16(ftmad_coeff16[imm]));
+	    float16x8_t nf = vreinterpretq_f16_u16(n);
+	    float16x8_t mf = vreinterpretq_f16_u16(vbicq_u16(m, sign));
+	    float16x8_t cf = vreinterpretq_f16_u16(c);
+	    float16x4_t lo = fmla_hf4(vget_low_f16(cf), vget_low_f16(nf),
+				      vget_low_f16(mf), true);
+	    float16x4_t hi = fmla_hf4(vget_high_f16(cf), vget_high_f16(nf),
+				      vget_high_f16(mf), true);
+	    uint16x8_t v = vreinterpretq_u16_f16(vcombine_f16(lo, hi));
+	    vst1q_u16(&result.h[e], v);
+	    break;
+	}
+	case 32: {
+	    int e = (4 * i);
+	    uint32x4_t m = vld1q_u32(&operand2->w[e]);
+	    uint32x4_t sign = vdupq_n_u32(0x80000000U);
+	    uint32x4_t c = vbslq_u32(vtstq_u32(m, sign),
+				     vdupq_n_u32(ftmad_coeff32[imm + 8]),
+				     vdupq_n_u32(ftmad_coeff32[imm]));
+	    float32x4_t n = vreinterpretq_f32_u32(vld1q_u32(&operand1->w[e]));
+	    float32x4_t a = vreinterpretq_f32_u32(vbicq_u32(m, sign));
+	    float32x4_t v = vfmaq_f32(vreinterpretq_f32_u32(c), n, a);
+	    vst1q_u32(&result.w[e], vreinterpretq_u32_f32(v));
+	    break;
+	}
+	case 64: {
+	    int e = (2 * i);
+	    uint64x2_t m = vld1q_u64(&operand2->x[e]);
+	    uint64x2_t sign = vdupq_n_u64(0x8000000000000000ULL);
+	    uint64x2_t c = vbslq_u64(vtstq_u64(m, sign),
+				     vdupq_n_u64(ftmad_coeff64[imm + 8]),
+				     vdupq_n_u64(ftmad_coeff64[imm]));
+	    float64x2_t n = vreinterpretq_f64_u64(vld1q_u64(&operand1->x[e]));
+	    float64x2_t a = vreinterpretq_f64_u64(vbicq_u64(m, sign));
+	    float64x2_t v = vfmaq_f64(vreinterpretq_f64_u64(c), n, a);
+	    vst1q_u64(&result.x[e], vreinterpretq_u64_f64(v));
+	    break;
+	}
+	default:
+	    assert(esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+    zx->z[Zdn] = result;
+}
+
+/* Makes 2^n for N in the normal range. */
+
+static inline float64x2_t
+exp2_df2(int64x2_t n)
+{
+    /*NEON*/
+    int64x2_t x = vshlq_n_s64(vaddq_s64(n, vdupq_n_s64(1023)), 52);
+    return vreinterpretq_f64_s64(x);
+}
+
+/* Scales double-precision lanes by 2^n.  It is scalbn() in musl.  It
+   multiplies by powers of two in the normal range, where all but the
+   last multiplications are exact.  It rises by 2^1023 steps, and
+   falls by 2^-969 steps, which leaves enough bits to avoid double
+   rounding at the last.  N is clamped in +/-2200, where the result
+   is saturated to infinity or zero beyond that. */
+
+static float64x2_t
+fscale_df2(float64x2_t x, int64x2_t n0)
+{
+    /*NEON*/
+    int64x2_t top = vdupq_n_s64(2200);
+    int64x2_t bottom = vdupq_n_s64(-2200);
+    int64x2_t n1 = vbslq_s64(vcgtq_s64(n0, top), top, n0);
+    int64x2_t n = vbslq_s64(vcltq_s64(n1, bottom), bottom, n1);
+    float64x2_t y = x;
+    for (int r = 0; r < 2; r++) {
+	uint64x2_t up = vcgtq_s64(n, vdupq_n_s64(1023));
+	uint64x2_t down = vcltq_s64(n, vdupq_n_s64(-1022));
+	int64x2_t s = vbslq_s64(up, vdupq_n_s64(1023),
+				vbslq_s64(down, vdupq_n_s64(-969),
+					  vdupq_n_s64(0)));
+	y = vmulq_f64(y, exp2_df2(s));
+	n = vsubq_s64(n, s);
+    }
+    return vmulq_f64(y, exp2_df2(n));
+}
+
+/* FSCALE.  It is Zdn := Zdn * 2^Zm with Zm as signed integers.
+   Half and single-precision are scaled in wider precision exactly
+   (with the clamped exponents), and rounded once at narrowing. */
+
+static void
+perform_FSCALE(svecxt_t *zx, int esize, int Zdn, int Zm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    preg mask = zx->p[Pg];
+    zreg *operand1 = &zx->z[Zdn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	switch (esize) {
+	case 16: {
+	    int e = (8 * i);
+	    uint16x8_t x0 = vld1q_u16(&operand1->h[e]);
+	    int16x8_t n0 = vreinterpretq_s16_u16(vld1q_u16(&operand2->h[e]));
+	    int16x8_t n = vmaxq_s16(vminq_s16(n0, vdupq_n_s16(64)),
+				    vdupq_n_s16(-64));
+	    float16x8_t x = vreinterpretq_f16_u16(x0);
+	    int32x4_t nlo = vmovl_s16(vget_low_s16(n));
+	    int32x4_t nhi = vmovl_high_s16(n);
+	    int32x4_t plo = vshlq_n_s32(vaddq_s32(nlo, vdupq_n_s32(127)), 23);
+	    int32x4_t phi = vshlq_n_s32(vaddq_s32(nhi, vdupq_n_s32(127)), 23);
+	    float32x4_t lo = vmulq_f32(vcvt_f32_f16(vget_low_f16(x)),
+				       vreinterpretq_f32_s32(plo));
+	    float32x4_t hi = vmulq_f32(vcvt_f32_f16(vget_high_f16(x)),
+				       vreinterpretq_f32_s32(phi));
+	    float16x8_t v = vcombine_f16(vcvt_f16_f32(lo), vcvt_f16_f32(hi));
+	    uint16x8_t k = ElemP_lanes16(zx, &mask, e);
+	    uint16x8_t r = vbslq_u16(k, vreinterpretq_u16_f16(v), x0);
+	    vst1q_u16(&result.h[e], r);
+	    break;
+	}
+	case 32: {
+	    int e = (4 * i);
+	    uint32x4_t x0 = vld1q_u32(&operand1->w[e]);
+	    int32x4_t n0 = vreinterpretq_s32_u32(vld1q_u32(&operand2->w[e]));
+	    int32x4_t n = vmaxq_s32(vminq_s32(n0, vdupq_n_s32(300)),
+				    vdupq_n_s32(-300));
+	    float32x4_t x = vreinterpretq_f32_u32(x0);
+	    float64x2_t lo = vmulq_f64(vcvt_f64_f32(vget_low_f32(x)),
+				       exp2_df2(vmovl_s32(vget_low_s32(n))));
+	    float64x2_t hi = vmulq_f64(vcvt_high_f64_f32(x),
+				       exp2_df2(vmovl_high_s32(n)));
+	    float32x4_t v = vcvt_high_f32_f64(vcvt_f32_f64(lo), hi);
+	    uint32x4_t k = ElemP_lanes32(zx, &mask, e);
+	    uint32x4_t r = vbslq_u32(k, vreinterpretq_u32_f32(v), x0);
+	    vst1q_u32(&result.w[e], r);
+	    break;
+	}
+	case 64: {
+	    int e = (2 * i);
+	    uint64x2_t x0 = vld1q_u64(&operand1->x[e]);
+	    int64x2_t n = vreinterpretq_s64_u64(vld1q_u64(&operand2->x[e]));
+	    float64x2_t v = fscale_df2(vreinterpretq_f64_u64(x0), n);
+	    uint64x2_t k = ElemP_lanes64(zx, &mask, e);
+	    uint64x2_t r = vbslq_u64(k, vreinterpretq_u64_f64(v), x0);
+	    vst1q_u64(&result.x[e], r);
+	    break;
+	}
+	default:
+	    assert(esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+    zx->z[Zdn] = result;
+}
+
+/* Returns the sign bits of the (real, imaginary) pairs in a 128-bit
+   segment, to negate the parts by XOR. */
+
+static uint8x16_t
+complex_signs(int esize, bool neg_r, bool neg_i)
+{
+    u64 sign = (1ULL << (esize - 1));
+    u64 r = (neg_r ? sign : 0);
+    u64 i = (neg_i ? sign : 0);
+    /*NEON*/
+    if (esize == 64) {
+	uint64x2_t v = vcombine_u64(vcreate_u64(r), vcreate_u64(i));
+	return vreinterpretq_u8_u64(v);
+    } else {
+	return Replicate_q((2 * esize), (r | (i << esize)));
+    }
+}
+
+/* Adds pairs of a 128-bit segment as FCADD, A + (M rotated by ROT).
+   It swaps the real and imaginary parts of M and negates one of them.
+   Half-precision adds by multiply-adds with one, to round once. */
+
+static uint8x16_t
+fcadd_q(int esize, int rot, uint8x16_t a, uint8x16_t m)
+{
+    assert(rot == 90 || rot == 270);
+    uint8x16_t signs = complex_signs(esize, (rot == 90), (rot == 270));
+    /*NEON*/
+    switch (esize) {
+    case 16: {
+	uint16x8_t m0 = vrev32q_u16(vreinterpretq_u16_u8(m));
+	uint8x16_t m1 = veorq_u8(vreinterpretq_u8_u16(m0), signs);
+	float16x8_t af = vreinterpretq_f16_u8(a);
+	float16x8_t mf = vreinterpretq_f16_u8(m1);
+	float16x4_t one = vreinterpret_f16_u16(vdup_n_u16(0x3c00));
+	float16x4_t lo = fmla_hf4(vget_low_f16(af), vget_low_f16(mf),
+				  one, true);
+	float16x4_t hi = fmla_hf4(vget_high_f16(af), vget_high_f16(mf),
+				  one, true);
+	return vreinterpretq_u8_f16(vcombine_f16(lo, hi));
+    }
+    case 32: {
+	uint32x4_t m0 = vrev64q_u32(vreinterpretq_u32_u8(m));
+	uint8x16_t m1 = veorq_u8(vreinterpretq_u8_u32(m0), signs);
+	float32x4_t v = vaddq_f32(vreinterpretq_f32_u8(a),
+				  vreinterpretq_f32_u8(m1));
+	return vreinterpretq_u8_f32(v);
+    }
+    case 64: {
+	uint64x2_t m0 = vreinterpretq_u64_u8(m);
+	uint64x2_t m1 = vextq_u64(m0, m0, 1);
+	uint8x16_t m2 = veorq_u8(vreinterpretq_u8_u64(m1), signs);
+	float64x2_t v = vaddq_f64(vreinterpretq_f64_u8(a),
+				  vreinterpretq_f64_u8(m2));
+	return vreinterpretq_u8_f64(v);
+    }
+    default:
+	assert(esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+/* Multiply-adds pairs of a 128-bit segment as FCMLA, A + N * M by
+   ROT.  It takes the real (or imaginary) part of N in both lanes of a
+   pair, takes M as is (or swapped), and negates parts of M. */
+
+static uint8x16_t
+fcmla_q(int esize, int rot, uint8x16_t a, uint8x16_t n, uint8x16_t m)
+{
+    assert(rot == 0 || rot == 90 || rot == 180 || rot == 270);
+    bool sel = (((rot / 90) & 1) != 0);
+    bool neg_i = (((rot / 90) & 2) != 0);
+    bool neg_r = (sel != neg_i);
+    uint8x16_t signs = complex_signs(esize, neg_r, neg_i);
+    /*NEON*/
+    switch (esize) {
+    case 16: {
+	uint16x8_t n0 = vreinterpretq_u16_u8(n);
+	uint16x8_t m0 = vreinterpretq_u16_u8(m);
+	uint16x8_t n1 = (sel ? vtrn2q_u16(n0, n0) : vtrn1q_u16(n0, n0));
+	uint16x8_t m1 = (sel ? vrev32q_u16(m0) : m0);
+	uint8x16_t m2 = veorq_u8(vreinterpretq_u8_u16(m1), signs);
+	float16x8_t af = vreinterpretq_f16_u8(a);
+	float16x8_t nf = vreinterpretq_f16_u16(n1);
+	float16x8_t mf = vreinterpretq_f16_u8(m2);
+	float16x4_t lo = fmla_hf4(vget_low_f16(af), vget_low_f16(nf),
+				  vget_low_f16(mf), true);
+	float16x4_t hi = fmla_hf4(vget_high_f16(af), vget_high_f16(nf),
+				  vget_high_f16(mf), true);
+	return vreinterpretq_u8_f16(vcombine_f16(lo, hi));
+    }
+    case 32: {
+	uint32x4_t n0 = vreinterpretq_u32_u8(n);
+	uint32x4_t m0 = vreinterpretq_u32_u8(m);
+	uint32x4_t n1 = (sel ? vtrn2q_u32(n0, n0) : vtrn1q_u32(n0, n0));
+	uint32x4_t m1 = (sel ? vrev64q_u32(m0) : m0);
+	uint8x16_t m2 = veorq_u8(vreinterpretq_u8_u32(m1), signs);
+	float32x4_t v = vfmaq_f32(vreinterpretq_f32_u8(a),
+				  vreinterpretq_f32_u32(n1),
+				  vreinterpretq_f32_u8(m2));
+	return vreinterpretq_u8_f32(v);
+    }
+    case 64: {
+	uint64x2_t n0 = vreinterpretq_u64_u8(n);
+	uint64x2_t m0 = vreinterpretq_u64_u8(m);
+	uint64x2_t n1 = (sel ? vtrn2q_u64(n0, n0) : vtrn1q_u64(n0, n0));
+	uint64x2_t m1 = (sel ? vextq_u64(m0, m0, 1) : m0);
+	uint8x16_t m2 = veorq_u8(vreinterpretq_u8_u64(m1), signs);
+	float64x2_t v = vfmaq_f64(vreinterpretq_f64_u8(a),
+				  vreinterpretq_f64_u64(n1),
+				  vreinterpretq_f64_u8(m2));
+	return vreinterpretq_u8_f64(v);
+    }
+    default:
+	assert(esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+/* FCADD.  It is Zdn := Zdn + (Zm rotated by ROT), for ROT=90 or
+   ROT=270 (in degrees). */
+
+static void
+perform_FCADD(svecxt_t *zx, int esize, int rot, int Zdn, int Zm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    preg mask = zx->p[Pg];
+    zreg *operand1 = &zx->z[Zdn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	int e = (i * (128 / esize));
+	uint8x16_t a = vld1q_u8(&operand1->b[16 * i]);
+	uint8x16_t m = vld1q_u8(&operand2->b[16 * i]);
+	uint8x16_t v = fcadd_q(esize, rot, a, m);
+	uint8x16_t k = ElemP_lanes(zx, &mask, e, esize);
+	vst1q_u8(&result.b[16 * i], vbslq_u8(k, v, a));
+    }
+    zx->z[Zdn] = result;
+}
+
+/* FCMLA (vectors).  It is Zda := Zda + Zn * Zm by ROT=0, 90, 180 or
+   270 (in degrees), where a pair of rotations makes a complex
+   multiply-add. */
+
+static void
+perform_FCMLA(svecxt_t *zx, int esize, int rot, int Zda, int Zn, int Zm,
+	      int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int segments = zx->VL / 128;
+    preg mask = zx->p[Pg];
+    zreg *operand1 = &zx->z[Zn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg *operand3 = &zx->z[Zda];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	int e = (i * (128 / esize));
+	uint8x16_t n = vld1q_u8(&operand1->b[16 * i]);
+	uint8x16_t m = vld1q_u8(&operand2->b[16 * i]);
+	uint8x16_t a = vld1q_u8(&operand3->b[16 * i]);
+	uint8x16_t v = fcmla_q(esize, rot, a, n, m);
+	uint8x16_t k = ElemP_lanes(zx, &mask, e, esize);
+	vst1q_u8(&result.b[16 * i], vbslq_u8(k, v, a));
+    }
+    zx->z[Zda] = result;
+}
+
+/* FCMLA (indexed).  The pair at INDEX of each 128-bit segment of Zm
+   multiplies the pairs of Zn in the segment.  It is unpredicated. */
+
+static void
+perform_FCMLA_indexed(svecxt_t *zx, int esize, int rot, int Zda, int Zn,
+		      int Zm, int index)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(esize == 16 || esize == 32);
+    assert(index >= 0 && index < (64 / esize));
+    int segments = zx->VL / 128;
+    zreg *operand1 = &zx->z[Zn];
+    zreg *operand2 = &zx->z[Zm];
+    zreg *operand3 = &zx->z[Zda];
+    zreg result = zreg_zeros;
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	uint8x16_t n = vld1q_u8(&operand1->b[16 * i]);
+	uint8x16_t a = vld1q_u8(&operand3->b[16 * i]);
+	uint8x16_t m;
+	if (esize == 16) {
+	    uint32x4_t m0 = vld1q_dup_u32(&operand2->w[(4 * i) + index]);
+	    m = vreinterpretq_u8_u32(m0);
+	} else {
+	    uint64x2_t m0 = vld1q_dup_u64(&operand2->x[(2 * i) + index]);
+	    m = vreinterpretq_u8_u64(m0);
+	}
+	vst1q_u8(&result.b[16 * i], fcmla_q(esize, rot, a, n, m));
+    }
+    zx->z[Zda] = result;
+}
+
+static void
+perform_FREDUCE_seq(svecxt_t *zx, int esize, Fop op, int Vd, int Zm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    int elements = zx->VL / esize;
+    preg mask = zx->p[Pg];
+    u64 operand1 = Vreg_get(zx, Vd);
+    zreg operand2 = zx->z[Zm];
+    u64 result = operand1;
+    for (int e = 0; e < elements; e++) {
+	if (ElemP_get(zx, &mask, e, esize) == 1) {
+	    u64 element = Elem_get(zx, &operand2, e, esize, DONTCARE);
+	    result = calculate_fop(esize, op, result, element);
+	}
+    }
+    Vreg_set(zx, Vd, result);
+}
+
+/* This is Reduce() and ReducePredicated() in the definition.  It
+   reduces level by level in place in a vector image, by the NEON
+   pairwise operators.  A pairwise operator combines adjacent
+   elements, so that the association order is the same as the
+   recursive halving in Reduce(), and the results are bit-identical.
+   The image is padded with the unit to a power of two. */
+
+static float32x4_t
+reduce_pairwise_sf(Fop op, float32x4_t x, float32x4_t y)
+{
+    /*NEON*/
+    switch (op) {
+    case Fop_ADD: return vpaddq_f32(x, y);
+    case Fop_MAX: return vpmaxq_f32(x, y);
+    case Fop_MIN: return vpminq_f32(x, y);
+    case Fop_MAXNUM: return vpmaxnmq_f32(x, y);
+    case Fop_MINNUM: return vpminnmq_f32(x, y);
+    default:
+	assert(op == Fop_ADD || op == Fop_MAX || op == Fop_MIN
+	       || op == Fop_MAXNUM || op == Fop_MINNUM);
+	abort();
+    }
+}
+
+static float64x2_t
+reduce_pairwise_df(Fop op, float64x2_t x, float64x2_t y)
+{
+    /*NEON*/
+    switch (op) {
+    case Fop_ADD: return vpaddq_f64(x, y);
+    case Fop_MAX: return vpmaxq_f64(x, y);
+    case Fop_MIN: return vpminq_f64(x, y);
+    case Fop_MAXNUM: return vpmaxnmq_f64(x, y);
+    case Fop_MINNUM: return vpminnmq_f64(x, y);
+    default:
+	assert(op == Fop_ADD || op == Fop_MAX || op == Fop_MIN
+	       || op == Fop_MAXNUM || op == Fop_MINNUM);
+	abort();
+    }
+}
+
+/* (Half-precision is reduced in single-precision, which rounds once
+   at each level). */
+
+static uint16x8_t
+reduce_pairwise_hf(Fop op, uint16x8_t x0, uint16x8_t y0)
+{
+    /*NEON*/
+    float16x8_t x = vreinterpretq_f16_u16(x0);
+    float16x8_t y = vreinterpretq_f16_u16(y0);
+    float32x4_t a = reduce_pairwise_sf(op, vcvt_f32_f16(vget_low_f16(x)),
+				       vcvt_high_f32_f16(x));
+    float32x4_t b = reduce_pairwise_sf(op, vcvt_f32_f16(vget_low_f16(y)),
+				       vcvt_high_f32_f16(y));
+    return vreinterpretq_u16_f16(vcvt_high_f16_f32(vcvt_f16_f32(a), b));
+}
+
+static void
+perform_FREDUCE_rec(svecxt_t *zx, int esize, Fop op, u64 unitv,
+		    int Vd, int Zm, int Pg)
+{
+    assert(zx != 0 && zx->ux != 0);
+    /*mcontext_t *ux = zx->ux;*/
+    CheckSVEEnabled();
+
+    assert(esize == 16 || esize == 32 || esize == 64);
+    int elements = zx->VL / esize;
+    int lanes = 128 / esize;
+    preg mask = zx->p[Pg];
+    zreg input = zx->z[Zm];
+    int elements2p = CeilPow2(elements);
+    zreg operands = zreg_zeros;
+    /*NEON*/
+    for (int e = 0; e < elements2p; e += lanes) {
+	if (esize == 16) {
+	    uint16x8_t v = vdupq_n_u16((u16)unitv);
+	    if (e < elements) {
+		uint16x8_t k = ElemP_lanes16(zx, &mask, e);
+		v = vbslq_u16(k, vld1q_u16(&input.h[e]), v);
+	    }
+	    vst1q_u16(&operands.h[e], v);
+	} else if (esize == 32) {
+	    uint32x4_t v = vdupq_n_u32((u32)unitv);
+	    if (e < elements) {
+		uint32x4_t k = ElemP_lanes32(zx, &mask, e);
+		v = vbslq_u32(k, vld1q_u32(&input.w[e]), v);
+	    }
+	    vst1q_u32(&operands.w[e], v);
+	} else {
+	    uint64x2_t v = vdupq_n_u64(unitv);
+	    if (e < elements) {
+		uint64x2_t k = ElemP_lanes64(zx, &mask, e);
+		v = vbslq_u64(k, vld1q_u64(&input.x[e]), v);
+	    }
+	    vst1q_u64(&operands.x[e], v);
+	}
+    }
+    for (int n = elements2p; n > 1; n /= 2) {
+	for (int e = 0; e < n; e += (2 * lanes)) {
+	    if (esize == 16) {
+		uint16x8_t x = vld1q_u16(&operands.h[e]);
+		uint16x8_t y = vld1q_u16(&operands.h[e + lanes]);
+		uint16x8_t v = reduce_pairwise_hf(op, x, y);
+		vst1q_u16(&operands.h[e / 2], v);
+	    } else if (esize == 32) {
+		uint32x4_t x = vld1q_u32(&operands.w[e]);
+		uint32x4_t y = vld1q_u32(&operands.w[e + lanes]);
+		float32x4_t v = reduce_pairwise_sf(op, vreinterpretq_f32_u32(x),
+						   vreinterpretq_f32_u32(y));
+		vst1q_u32(&operands.w[e / 2], vreinterpretq_u32_f32(v));
+	    } else {
+		uint64x2_t x = vld1q_u64(&operands.x[e]);
+		uint64x2_t y = vld1q_u64(&operands.x[e + lanes]);
+		float64x2_t v = reduce_pairwise_df(op, vreinterpretq_f64_u64(x),
+						   vreinterpretq_f64_u64(y));
+		vst1q_u64(&operands.x[e / 2], vreinterpretq_u64_f64(v));
+	    }
+	}
+    }
+    u64 v = ((esize == 16) ? (u64)operands.h[0]
+	     : ((esize == 32) ? (u64)operands.w[0] : operands.x[0]));
+    Vreg_set(zx, Vd, v);
+}
+
+/* NEON KERNELS of integer reductions.  Inactive elements are
+   replaced by the unit with a select.  Then, segments are combined
+   lane-wise, and finally the lanes are combined.  Sums are widened
+   pairwise to 64 bits on the way. */
+
+static uint8x16_t
+ireduce_unit(int esize, u64 unitv)
+{
+    /*NEON*/
+    switch (esize) {
+    case 8: return vdupq_n_u8((u8)unitv);
+    case 16: return vreinterpretq_u8_u16(vdupq_n_u16((u16)unitv));
+    case 32: return vreinterpretq_u8_u32(vdupq_n_u32((u32)unitv));
+    case 64: return vreinterpretq_u8_u64(vdupq_n_u64(unitv));
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
+    }
+}
+
+static uint64x2_t
+ireduce_widen(int esize, enum signedness signedp, uint8x16_t v)
+{
+    /*NEON*/
+    if (signedp == S64EXT) {
+	switch (esize) {
+	case 8:
+	    return vreinterpretq_u64_s64(vpaddlq_s32(vpaddlq_s16(vpaddlq_s8(vreinterpretq_s8_u8(v)))));
+	case 16:
+	    return vreinterpretq_u64_s64(vpaddlq_s32(vpaddlq_s16(vreinterpretq_s16_u8(v))));
+	case 32:
+	    return vreinterpretq_u64_s64(vpaddlq_s32(vreinterpretq_s32_u8(v)));
+	case 64:
+	    return vreinterpretq_u64_u8(v);
+	default:
+	    assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    } else {
+	switch (esize) {
+	case 8:
+	    return vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(v)));
+	case 16:
+	    return vpaddlq_u32(vpaddlq_u16(vreinterpretq_u16_u8(v)));
+	case 32:
+	    return vpaddlq_u32(vreinterpretq_u32_u8(v));
+	case 64:
+	    return vreinterpretq_u64_u8(v);
+	default:
+	    assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	    abort();
+	}
+    }
+}
+
+static uint8x16_t
+ireduce_minmax(int esize, Iop op, uint8x16_t x, uint8x16_t y)
+{
+    bool maxp = (op == Iop_SMAX || op == Iop_UMAX);
+    bool signedp = (op == Iop_SMAX || op == Iop_SMIN);
+    /*NEON*/
+    switch (esize) {
+    case 8:
+	if (signedp) {
+	    int8x16_t a = vreinterpretq_s8_u8(x);
+	    int8x16_t b = vreinterpretq_s8_u8(y);
+	    return vreinterpretq_u8_s8(maxp ? vmaxq_s8(a, b) : vminq_s8(a, b));
+	} else {
+	    return (maxp ? vmaxq_u8(x, y) : vminq_u8(x, y));
+	}
+    case 16:
+	if (signedp) {
+	    int16x8_t a = vreinterpretq_s16_u8(x);
+	    int16x8_t b = vreinterpretq_s16_u8(y);
+	    return vreinterpretq_u8_s16(maxp ? vmaxq_s16(a, b) : vminq_s16(a, b));
+	} else {
+	    uint16x8_t a = vreinterpretq_u16_u8(x);
+	    uint16x8_t b = vreinterpretq_u16_u8(y);
+	    return vreinterpretq_u8_u16(maxp ? vmaxq_u16(a, b) : vminq_u16(a, b));
+	}
+    case 32:
+	if (signedp) {
+	    int32x4_t a = vreinterpretq_s32_u8(x);
+	    int32x4_t b = vreinterpretq_s32_u8(y);
+	    return vreinterpretq_u8_s32(maxp ? vmaxq_s32(a, b) : vminq_s32(a, b));
+	} else {
+	    uint32x4_t a = vreinterpretq_u32_u8(x);
+	    uint32x4_t b = vreinterpretq_u32_u8(y);
+	    return vreinterpretq_u8_u32(maxp ? vmaxq_u32(a, b) : vminq_u32(a, b));
+	}
+    case 64: {
+	/* NEON has no 64-bit max/min. */
+	uint64x2_t a = vreinterpretq_u64_u8(x);
+	uint64x2_t b = vreinterpretq_u64_u8(y);
+	uint64x2_t gt;
+	if (signedp) {
+	    gt = vcgtq_s64(vreinterpretq_s64_u8(x), vreinterpretq_s64_u8(y));
+	} else {
+	    gt = vcgtq_u64(a, b);
 	}
+	return vreinterpretq_u8_u64(maxp ? vbslq_u64(gt, a, b) : vbslq_u64(gt, b, a));
+    }
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
     }
-    zx->z[Zdn] = result;
 }
 
-/* Zd := Za + sub_op(Zn * Zm) */
+/* Combines the lanes of max/min.  The result is in the element size
+   (zero-extended). */
 
-static void
-perform_IFMA(svecxt_t *zx, int esize, int Zd,
-	     int Za, bool sub_op, int Zn, int Zm, int Pg)
+static u64
+ireduce_minmax_lanes(int esize, Iop op, uint8x16_t v)
 {
-    assert(zx != 0 && zx->ux != 0);
-    /*mcontext_t *ux = zx->ux;*/
-    CheckSVEEnabled();
-
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg oldvalue = zx->z[Zd];
-    zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
-    zreg operand3 = zx->z[Za];
-    zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	u64 element2 = Elem_get(zx, &operand2, e, esize, DONTCARE);
-	u64 element3 = Elem_get(zx, &operand3, e, esize, DONTCARE);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    if (sub_op) {
-		u64 v = (element3 - (element1 * element2));
-		Elem_set(zx, &result, e, esize, v);
-	    } else {
-		u64 v = (element3 + (element1 * element2));
-		Elem_set(zx, &result, e, esize, v);
-	    }
+    bool maxp = (op == Iop_SMAX || op == Iop_UMAX);
+    bool signedp = (op == Iop_SMAX || op == Iop_SMIN);
+    /*NEON*/
+    switch (esize) {
+    case 8:
+	if (signedp) {
+	    int8x16_t a = vreinterpretq_s8_u8(v);
+	    return (u64)(u8)(maxp ? vmaxvq_s8(a) : vminvq_s8(a));
 	} else {
-	    u64 v = Elem_get(zx, &oldvalue, e, esize, DONTCARE);
-	    Elem_set(zx, &result, e, esize, v);
+	    return (u64)(maxp ? vmaxvq_u8(v) : vminvq_u8(v));
+	}
+    case 16:
+	if (signedp) {
+	    int16x8_t a = vreinterpretq_s16_u8(v);
+	    return (u64)(u16)(maxp ? vmaxvq_s16(a) : vminvq_s16(a));
+	} else {
+	    uint16x8_t a = vreinterpretq_u16_u8(v);
+	    return (u64)(maxp ? vmaxvq_u16(a) : vminvq_u16(a));
+	}
+    case 32:
+	if (signedp) {
+	    int32x4_t a = vreinterpretq_s32_u8(v);
+	    return (u64)(u32)(maxp ? vmaxvq_s32(a) : vminvq_s32(a));
+	} else {
+	    uint32x4_t a = vreinterpretq_u32_u8(v);
+	    return (u64)(maxp ? vmaxvq_u32(a) : vminvq_u32(a));
 	}
+    case 64: {
+	uint64x2_t a = vreinterpretq_u64_u8(v);
+	return calculate_iop(esize, op, vgetq_lane_u64(a, 0),
+			     vgetq_lane_u64(a, 1));
+    }
+    default:
+	assert(esize == 8 || esize == 16 || esize == 32 || esize == 64);
+	abort();
     }
-    zx->z[Zd] = result;
 }
 
-/* Zd := (op3_neg Za) + ((op1_neg Zn) * Zm) */
+/* Combines the lanes of bitwise operations by folding halves.  The
+   result is in the element size (zero-extended). */
 
-static void
-perform_FFMA(svecxt_t *zx, int esize, int Zd,
-	     bool op3_neg, int Za, bool op1_neg, int Zn, int Zm, int Pg)
+static u64
+ireduce_bitwise_lanes(int esize, Iop op, uint8x16_t v)
 {
-    assert(zx != 0 && zx->ux != 0);
-    /*mcontext_t *ux = zx->ux;*/
-    CheckSVEEnabled();
-
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
-    zreg operand3 = zx->z[Za];
-    zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	assert(esize == 32 || esize == 64);
-	u64 element1 = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	u64 element2 = Elem_get(zx, &operand2, e, esize, DONTCARE);
-	u64 element3 = Elem_get(zx, &operand3, e, esize, DONTCARE);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    if (op1_neg) {element1 = FPNeg(element1, esize);}
-	    if (op3_neg) {element3 = FPNeg(element3, esize);}
-	    u64 v = FPMulAdd(element3, element1, element2, esize, zx->FPCR);
-	    Elem_set(zx, &result, e, esize, v);
-	} else {
-	    Elem_set(zx, &result, e, esize, element3);
-	}
+    /*NEON*/
+    uint64x2_t a = vreinterpretq_u64_u8(v);
+    u64 x = calculate_iop(64, op, vgetq_lane_u64(a, 0), vgetq_lane_u64(a, 1));
+    for (int w = 32; w >= esize; w /= 2) {
+	x = calculate_iop(64, op, x, (x >> w));
     }
-    zx->z[Zd] = result;
+    return ((esize == 64) ? x : (x & ((1ULL << esize) - 1)));
 }
 
+/* SADDV and UADDV results are 64 bits.  Others are in the element
+   size (zero-extended). */
+
 static void
-perform_FREDUCE_seq(svecxt_t *zx, int esize, Fop op, int Vd, int Zm, int Pg)
+perform_IREDUCE_seq(svecxt_t *zx, int esize, Iop op,
+		    enum signedness signedp, u64 unitv,
+		    int Vd, int Zn, int Pg)
 {
     assert(zx != 0 && zx->ux != 0);
     /*mcontext_t *ux = zx->ux;*/
     CheckSVEEnabled();
 
-    int elements = zx->VL / esize;
+    int segments = zx->VL / 128;
+    int lanes = 128 / esize;
     preg mask = zx->p[Pg];
-    u64 operand1 = Vreg_get(zx, Vd);
-    zreg operand2 = zx->z[Zm];
-    u64 result = operand1;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 element = Elem_get(zx, &operand2, e, esize, DONTCARE);
-	    result = calculate_fop(esize, op, result, element);
+    zreg operand = zx->z[Zn];
+    uint8x16_t unit = ireduce_unit(esize, unitv);
+    u64 result;
+    /*NEON*/
+    if (op == Iop_ADD) {
+	uint64x2_t acc = vdupq_n_u64(0ULL);
+	for (int i = 0; i < segments; i++) {
+	    uint8x16_t k = ElemP_lanes(zx, &mask, (lanes * i), esize);
+	    uint8x16_t v = vbslq_u8(k, vld1q_u8(&operand.b[16 * i]), unit);
+	    acc = vaddq_u64(acc, ireduce_widen(esize, signedp, v));
+	}
+	result = vaddvq_u64(acc);
+    } else {
+	uint8x16_t acc = unit;
+	for (int i = 0; i < segments; i++) {
+	    uint8x16_t k = ElemP_lanes(zx, &mask, (lanes * i), esize);
+	    uint8x16_t v = vbslq_u8(k, vld1q_u8(&operand.b[16 * i]), unit);
+	    switch (op) {
+	    case Iop_AND: acc = vandq_u8(acc, v); break;
+	    case Iop_IOR: acc = vorrq_u8(acc, v); break;
+	    case Iop_XOR: acc = veorq_u8(acc, v); break;
+	    case Iop_SMAX: case Iop_SMIN: case Iop_UMAX: case Iop_UMIN:
+		acc = ireduce_minmax(esize, op, acc, v);
+		break;
+	    default:
+		assert(op == Iop_AND || op == Iop_IOR || op == Iop_XOR
+		       || op == Iop_SMAX || op == Iop_SMIN
+		       || op == Iop_UMAX || op == Iop_UMIN);
+		abort();
+	    }
+	}
+	if (op == Iop_AND || op == Iop_IOR || op == Iop_XOR) {
+	    result = ireduce_bitwise_lanes(esize, op, acc);
+	} else {
+	    result = ireduce_minmax_lanes(esize, op, acc);
 	}
     }
     Vreg_set(zx, Vd, result);
 }
 
-/* This is Reduce() and ReducePredicated() in the definition. */
+/* DOT-PRODUCT KERNELS.  A kernel computes a 128-bit segment of
+   SDOT/UDOT, ACC plus the 4-way dot-products of N and M.  The DOTPROD
+   one needs the DotProd extension (ARMv8.2) on the host.  The NEON
+   one widens the products and adds them pairwise.  The scalar one is
+   the reference. */
 
-static u64
-reduce_fop_rec(int esize, Fop op, u64 v[], int b, int n)
+static uint32x4_t __attribute__ ((target ("arch=armv8.2-a+dotprod")))
+dotp_kernel_dotprod_32(enum signedness signedp,
+		       uint32x4_t acc, uint8x16_t n, uint8x16_t m)
 {
-    assert(b >= 0 && powerof2p(n));
-    if (n == 1) {
-	return v[b];
+    /*NEON*/
+    if (signedp == S64EXT) {
+	int32x4_t v = vdotq_s32(vreinterpretq_s32_u32(acc),
+				vreinterpretq_s8_u8(n), vreinterpretq_s8_u8(m));
+	return vreinterpretq_u32_s32(v);
     } else {
-	int h = n / 2;
-	u64 x = reduce_fop_rec(esize, op, v, b, h);
-	u64 y = reduce_fop_rec(esize, op, v, (b + h), h);
-	return calculate_fop(esize, op, x, y);
+	return vdotq_u32(acc, n, m);
     }
 }
 
-static void
-perform_FREDUCE_rec(svecxt_t *zx, int esize, Fop op, u64 unitv,
-		    int Vd, int Zm, int Pg)
+static uint32x4_t
+dotp_kernel_neon_32(enum signedness signedp,
+		    uint32x4_t acc, uint8x16_t n, uint8x16_t m)
 {
-    assert(zx != 0 && zx->ux != 0);
-    /*mcontext_t *ux = zx->ux;*/
-    CheckSVEEnabled();
+    /*NEON*/
+    if (signedp == S64EXT) {
+	int8x16_t a = vreinterpretq_s8_u8(n);
+	int8x16_t b = vreinterpretq_s8_u8(m);
+	int16x8_t lo = vmull_s8(vget_low_s8(a), vget_low_s8(b));
+	int16x8_t hi = vmull_high_s8(a, b);
+	int32x4_t v = vpaddq_s32(vpaddlq_s16(lo), vpaddlq_s16(hi));
+	return vaddq_u32(acc, vreinterpretq_u32_s32(v));
+    } else {
+	uint16x8_t lo = vmull_u8(vget_low_u8(n), vget_low_u8(m));
+	uint16x8_t hi = vmull_high_u8(n, m);
+	uint32x4_t v = vpaddq_u32(vpaddlq_u16(lo), vpaddlq_u16(hi));
+	return vaddq_u32(acc, v);
+    }
+}
 
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg input = zx->z[Zm];
-    int elements2p = CeilPow2(elements);
-    u64 operands[elements2p];
-    for (int e = 0; e < elements2p; e++) {
-	if (e < elements && ElemP_get(zx, &mask, e, esize) == 1) {
-	    operands[e] = Elem_get(zx, &input, e, esize, DONTCARE);
-	} else {
-	    operands[e] = unitv;
-	}
+static uint64x2_t
+dotp_kernel_neon_64(enum signedness signedp,
+		    uint64x2_t acc, uint8x16_t n, uint8x16_t m)
+{
+    /*NEON*/
+    if (signedp == S64EXT) {
+	int16x8_t a = vreinterpretq_s16_u8(n);
+	int16x8_t b = vreinterpretq_s16_u8(m);
+	int32x4_t lo = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+	int32x4_t hi = vmull_high_s16(a, b);
+	int64x2_t v = vpaddq_s64(vpaddlq_s32(lo), vpaddlq_s32(hi));
+	return vaddq_u64(acc, vreinterpretq_u64_s64(v));
+    } else {
+	uint16x8_t a = vreinterpretq_u16_u8(n);
+	uint16x8_t b = vreinterpretq_u16_u8(m);
+	uint32x4_t lo = vmull_u16(vget_low_u16(a), vget_low_u16(b));
+	uint32x4_t hi = vmull_high_u16(a, b);
+	uint64x2_t v = vpaddq_u64(vpaddlq_u32(lo), vpaddlq_u32(hi));
+	return vaddq_u64(acc, v);
     }
-    u64 v = reduce_fop_rec(esize, op, operands, 0, elements2p);
-    Vreg_set(zx, Vd, v);
 }
 
 static void
-perform_IREDUCE_seq(svecxt_t *zx, int esize, Iop op,
-		    enum signedness signedp, u64 unitv,
-		    int Vd, int Zn, int Pg)
+dotp_kernel_scalar(svecxt_t *zx, int esize, bool indexed,
+		   enum signedness signedp, zreg *operand1, zreg *operand2,
+		   zreg *operand3, int index, zreg *result)
 {
-    assert(zx != 0 && zx->ux != 0);
-    /*mcontext_t *ux = zx->ux;*/
-    CheckSVEEnabled();
-
     int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg operand = zx->z[Zn];
-    u64 result;
-    result = unitv;
+    int eltspersegment = 128 / esize;
     for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 element = Elem_get(zx, &operand, e, esize, signedp);
-	    result = calculate_iop(esize, op, result, element);
+	int segmentbase = e - (e % eltspersegment);
+	int s = (!indexed ? e : (segmentbase + index));
+	u64 res = Elem_get(zx, operand3, e, esize, signedp);
+	for (int i = 0; i < 4; i++) {
+	    u64 element1 = Elem_get(zx, operand1, (4 * e + i),
+				    (esize / 4), signedp);
+	    u64 element2 = Elem_get(zx, operand2, (4 * s + i),
+				    (esize / 4), signedp);
+	    res = res + element1 * element2;
 	}
+	Elem_set(zx, result, e, esize, res);
     }
-    Vreg_set(zx, Vd, result);
 }
 
 static void
@@ -3629,24 +7040,42 @@ perform_DOTP(svecxt_t *zx, int esize, bool indexed, enum signedness signedp,
     CheckSVEEnabled();
 
     /*vectors/indexed*/
-    int elements = zx->VL / esize;
-    int eltspersegment = 128 / esize;
+    assert(esize == 32 || esize == 64);
+    int segments = zx->VL / 128;
     zreg operand1 = zx->z[Zn];
     zreg operand2 = zx->z[Zm];
     zreg operand3 = zx->z[Zda];
     zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	int segmentbase = e - (e % eltspersegment);
-	int s = (!indexed ? e : (segmentbase + index));
-	u64 res = Elem_get(zx, &operand3, e, esize, signedp);
-	for (int i = 0; i < 4; i++) {
-	    u64 element1 = Elem_get(zx, &operand1, (4 * e + i),
-				    (esize / 4), signedp);
-	    u64 element2 = Elem_get(zx, &operand2, (4 * s + i),
-				    (esize / 4), signedp);
-	    res = res + element1 * element2;
+    if (dotp_kernel == KERNEL_SCALAR) {
+	dotp_kernel_scalar(zx, esize, indexed, signedp,
+			   &operand1, &operand2, &operand3, index, &result);
+	zx->z[Zda] = result;
+	return;
+    }
+    /*NEON*/
+    for (int i = 0; i < segments; i++) {
+	uint8x16_t n = vld1q_u8(&operand1.b[16 * i]);
+	uint8x16_t m;
+	if (!indexed) {
+	    m = vld1q_u8(&operand2.b[16 * i]);
+	} else if (esize == 32) {
+	    m = vreinterpretq_u8_u32(vdupq_n_u32(operand2.w[4 * i + index]));
+	} else {
+	    m = vreinterpretq_u8_u64(vdupq_n_u64(operand2.x[2 * i + index]));
+	}
+	if (esize == 32) {
+	    uint32x4_t acc = vld1q_u32(&operand3.w[4 * i]);
+	    if (dotp_kernel == KERNEL_DOTPROD) {
+		acc = dotp_kernel_dotprod_32(signedp, acc, n, m);
+	    } else {
+		acc = dotp_kernel_neon_32(signedp, acc, n, m);
+	    }
+	    vst1q_u32(&result.w[4 * i], acc);
+	} else {
+	    uint64x2_t acc = vld1q_u64(&operand3.x[2 * i]);
+	    acc = dotp_kernel_neon_64(signedp, acc, n, m);
+	    vst1q_u64(&result.x[2 * i], acc);
 	}
-	Elem_set(zx, &result, e, esize, res);
     }
     zx->z[Zda] = result;
 }
@@ -4181,17 +7610,8 @@ static inline void yasve_cntp_0x25208000 (CTXARG, int Rd, int Pg, int Pn) {
     NOTTESTED();
     int esize = (8 << size);
     CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    preg operand = zx->p[Pn];
-    u64 sum = 0;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1
-	    && ElemP_get(zx, &operand, e, esize) == 1) {
-	    sum = sum + 1;
-	}
-    }
-    Xreg_set(zx, Rd, sum);
+    int count = preg_count(zx, &zx->p[Pg], &zx->p[Pn], esize);
+    Xreg_set(zx, Rd, (u64)count);
 }
 static inline void yasve_cntw_0x04a0e000 (CTXARG, int Rd, int pattern, s64 imm) {
     //NOTTESTED00();
@@ -4204,21 +7624,7 @@ static inline void yasve_compact_0x05218000 (CTXARG, int Zd, int Pg, int Zn) {
     NOTTESTED();
     /*int esize = (32 << sz);*/
     int esize = (8 << size);
-    CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg operand1 = zx->z[Zn];
-    zreg result = zreg_zeros;
-    int x = 0;
-    for (int e = 0; e < elements; e++) {
-	Elem_set(zx, &result, e, esize, 0);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 element = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	    Elem_set(zx, &result, x, esize, element);
-	    x = x + 1;
-	}
-    }
-    zx->z[Zd] = result;
+    perform_COMPACT_z(zx, esize, Zd, Pg, Zn);
 }
 static inline void yasve_cpy_0x05208000 (CTXARG, int Zd, int Pg, int Vn) {
     NOTTESTED();
@@ -4356,12 +7762,8 @@ static inline void yasve_dup_0x05203800 (CTXARG, int Zd, int Rn) {
     //NOTTESTED00();
     int esize = (8 << size);
     CheckSVEEnabled();
-    int elements = zx->VL / esize;
     u64 operand = Xreg_get(zx, Rn, X31SP);
-    zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	Elem_set(zx, &result, e, esize, operand);
-    }
+    zreg result = Replicate_z(zx, esize, operand);
     zx->z[Zd] = result;
 }
 static inline void yasve_dup_0x05202000 (CTXARG, int Zd, int Zn, s64 imm) {
@@ -4462,24 +7864,8 @@ static inline void yasve_eorv_0x04192000 (CTXARG, int Vd, int Pg, int Zn) {
 }
 static inline void yasve_ext_0x05200000 (CTXARG, int Zd, int _Zd, int Zm, s64 imm) {
     NOTTESTED();
-    int esize = 8;
     int position = (int)imm;
-    CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    zreg operand1 = zx->z[Zd];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    if (position >= elements) {
-	position = 0;
-    }
-    position = position << 3;
-    size_t vlen = (size_t)(zx->VL / 8);
-    u8 concat[vlen * 2];
-    memcpy(&concat[0], &operand1, vlen);
-    memcpy(&concat[vlen], &operand2, vlen);
-    memset(&result, 0, sizeof(result));
-    memcpy(&result, &concat[position / 8], vlen);
-    zx->z[Zd] = result;
+    perform_EXT_z(zx, Zd, Zm, position);
 }
 
 static inline void yasve_fabd_0x65088000 (CTXARG, int Zd, int Pg, int _Zd, int Zm) {
@@ -4544,23 +7930,39 @@ static inline void yasve_faddv_0x65002000 (CTXARG, int Vd, int Pg, int Zn) {
 
 static inline void yasve_fcadd_0x64008000 (CTXARG, int Zd, int Pg, int _Zd, int Zm, s64 imm) {
     /* (SVE_Zd, SVE_Pg3, SVE_Zd, SVE_Zm_5, SVE_IMM_ROT1) */
-    TBD("fcadd");
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    int rot = ((((opc >> 16) & 1) == 0) ? 90 : 270);
+    perform_FCADD(zx, esize, rot, Zd, Zm, Pg);
 }
 
 static inline void yasve_fcmla_0x64000000 (CTXARG, int Zd, int Pg, int Zn, int Zm, s64 imm) {
     /* (vectors) */
     /* (SVE_Zd, SVE_Pg3, SVE_Zn, SVE_Zm_16, IMM_ROT2) */
-    TBD("fcmla");
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    int rot = (90 * (int)((opc >> 13) & 3));
+    perform_FCMLA(zx, esize, rot, Zd, Zn, Zm, Pg);
 }
 static inline void yasve_fcmla_0x64a01000 (CTXARG, int Zd, int Zn, int Zm, s64 imm) {
     /* (indexed/Half-precision) */
     /* (SVE_Zd, SVE_Zn, SVE_Zm3_INDEX, SVE_IMM_ROT2) */
-    TBD("fcmla");
+    NOTTESTED();
+    int esize = 16;
+    int rot = (90 * (int)((opc >> 10) & 3));
+    int index = (int)((opc >> 19) & 3);
+    perform_FCMLA_indexed(zx, esize, rot, Zd, Zn, Zm, index);
 }
 static inline void yasve_fcmla_0x64e01000 (CTXARG, int Zd, int Zn, int Zm, s64 imm) {
     /* (indexed/Single-precision) */
     /* (SVE_Zd, SVE_Zn, SVE_Zm4_INDEX, SVE_IMM_ROT2) */
-    TBD("fcmla");
+    NOTTESTED();
+    int esize = 32;
+    int rot = (90 * (int)((opc >> 10) & 3));
+    int index = (int)((opc >> 20) & 1);
+    perform_FCMLA_indexed(zx, esize, rot, Zd, Zn, Zm, index);
 }
 
 static inline void yasve_fcmeq_0x65122000 (CTXARG, int Pd, int Pg, int Zn, s64 zero) {
@@ -4686,15 +8088,21 @@ static inline void yasve_fcvt_0x65cba000 (CTXARG, int Zd, int Pg, int Zn) {
 
 static inline void yasve_fcvtzs_0x655aa000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (Half-precision to 16-bit) */
-    TBD("fcvtzs");
+    NOTTESTED();
+    int esize = 16;
+    perform_FOP_z(zx, esize, Fop_CVTI_16_S16, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_fcvtzs_0x655ca000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (Half-precision to 32-bit) */
-    TBD("fcvtzs");
+    NOTTESTED();
+    int esize = 32;
+    perform_FOP_z(zx, esize, Fop_CVTI_16_S32, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_fcvtzs_0x655ea000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (Half-precision to 64-bit) */
-    TBD("fcvtzs");
+    NOTTESTED();
+    int esize = 64;
+    perform_FOP_z(zx, esize, Fop_CVTI_16_S64, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_fcvtzs_0x659ca000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (Single-precision to 32-bit) */
@@ -4723,15 +8131,21 @@ static inline void yasve_fcvtzs_0x65dea000 (CTXARG, int Zd, int Pg, int Zn) {
 
 static inline void yasve_fcvtzu_0x655ba000 (CTXARG, int Zd, int Pg3, int Zn) {
     /* (Half-precision to 16-bit) */
-    TBD("fcvtzu");
+    NOTTESTED();
+    int esize = 16;
+    perform_FOP_z(zx, esize, Fop_CVTI_16_U16, true, Zd, 99, Zn, Pg3);
 }
 static inline void yasve_fcvtzu_0x655da000 (CTXARG, int Zd, int Pg3, int Zn) {
     /* (Half-precision to 32-bit) */
-    TBD("fcvtzu");
+    NOTTESTED();
+    int esize = 32;
+    perform_FOP_z(zx, esize, Fop_CVTI_16_U32, true, Zd, 99, Zn, Pg3);
 }
 static inline void yasve_fcvtzu_0x655fa000 (CTXARG, int Zd, int Pg3, int Zn) {
     /* (Half-precision to 64-bit) */
-    TBD("fcvtzu");
+    NOTTESTED();
+    int esize = 64;
+    perform_FOP_z(zx, esize, Fop_CVTI_16_U64, true, Zd, 99, Zn, Pg3);
 }
 static inline void yasve_fcvtzu_0x659da000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (Single-precision to 32-bit) */
@@ -4775,8 +8189,10 @@ static inline void yasve_fdup_0x2539c000 (CTXARG, int Zd, s64 imm) {
     perform_FOP_imm(zx, esize, Fop_CPY, false, Zd, immv, 99);
 }
 static inline void yasve_fexpa_0x0420b800 (CTXARG, int Zd, int Zn) {
-    /* (SVE_Zd, SVE_Zn) */
-    TBD("fexpa");
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    perform_FEXPA(zx, esize, Zd, Zn);
 }
 static inline void yasve_fmad_0x65208000 (CTXARG, int Zd, int Pg, int Zm, int Za) {
     /* (Zd := Za + Zd * Zm) */
@@ -4867,15 +8283,27 @@ static inline void yasve_fmla_0x65200000 (CTXARG, int Zd, int Pg, int Zn, int Zm
 
 static inline void yasve_fmla_0x64200000 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Half-precision) */
-    TBD("fmla");
+    /* (Zd := Zd + Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 16;
+    int index = (int)((((opc >> 22) & 0x1) << 2) | ((opc >> 19) & 0x3));
+    perform_FMLA_indexed(zx, esize, true, false, Zd, Zn, Zm, index);
 }
 static inline void yasve_fmla_0x64a00000 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Single-precision) */
-    TBD("fmla");
+    /* (Zd := Zd + Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 32;
+    int index = (int)((opc >> 19) & 0x3);
+    perform_FMLA_indexed(zx, esize, true, false, Zd, Zn, Zm, index);
 }
 static inline void yasve_fmla_0x64e00000 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Double-precision) */
-    TBD("fmla");
+    /* (Zd := Zd + Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 64;
+    int index = (int)((opc >> 20) & 0x1);
+    perform_FMLA_indexed(zx, esize, true, false, Zd, Zn, Zm, index);
 }
 
 static inline void yasve_fmls_0x65202000 (CTXARG, int Zd, int Pg, int Zn, int Zm) {
@@ -4888,15 +8316,27 @@ static inline void yasve_fmls_0x65202000 (CTXARG, int Zd, int Pg, int Zn, int Zm
 }
 static inline void yasve_fmls_0x64200400 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Half-precision) */
-    TBD("fmla");
+    /* (Zd := Zd + -Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 16;
+    int index = (int)((((opc >> 22) & 0x1) << 2) | ((opc >> 19) & 0x3));
+    perform_FMLA_indexed(zx, esize, true, true, Zd, Zn, Zm, index);
 }
 static inline void yasve_fmls_0x64a00400 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Single-precision) */
-    TBD("fmla");
+    /* (Zd := Zd + -Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 32;
+    int index = (int)((opc >> 19) & 0x3);
+    perform_FMLA_indexed(zx, esize, true, true, Zd, Zn, Zm, index);
 }
 static inline void yasve_fmls_0x64e00400 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Double-precision) */
-    TBD("fmla");
+    /* (Zd := Zd + -Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 64;
+    int index = (int)((opc >> 20) & 0x1);
+    perform_FMLA_indexed(zx, esize, true, true, Zd, Zn, Zm, index);
 }
 
 static inline void yasve_fmsb_0x6520a000 (CTXARG, int Zd, int Pg, int Zm, int Za) {
@@ -4925,20 +8365,33 @@ static inline void yasve_fmul_0x651a8000 (CTXARG, int Zd, int Pg, int _Zd, s64 i
 }
 static inline void yasve_fmul_0x64202000 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Half-precision) */
-    TBD("fmla");
+    /* (Zd := Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 16;
+    int index = (int)((((opc >> 22) & 0x1) << 2) | ((opc >> 19) & 0x3));
+    perform_FMLA_indexed(zx, esize, false, false, Zd, Zn, Zm, index);
 }
 static inline void yasve_fmul_0x64a02000 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Single-precision) */
-    TBD("fmla");
+    /* (Zd := Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 32;
+    int index = (int)((opc >> 19) & 0x3);
+    perform_FMLA_indexed(zx, esize, false, false, Zd, Zn, Zm, index);
 }
 static inline void yasve_fmul_0x64e02000 (CTXARG, int Zd, int Zn, int Zm) {
     /* (indexed/Double-precision) */
-    TBD("fmla");
+    /* (Zd := Zn * Zm[index]) */
+    NOTTESTED();
+    int esize = 64;
+    int index = (int)((opc >> 20) & 0x1);
+    perform_FMLA_indexed(zx, esize, false, false, Zd, Zn, Zm, index);
 }
 
 static inline void yasve_fmulx_0x650a8000 (CTXARG, int Zd, int Pg, int _Zd, int Zm) {
-    /* (SVE_Zd, SVE_Pg3, SVE_Zd, SVE_Zm_5) */
-    TBD("fmulx");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_MULX, true, Zd, 99, Zm, Pg);
 }
 
 static inline void yasve_fneg_0x041da000 (CTXARG, int Zd, int Pg, int Zn) {
@@ -4991,28 +8444,44 @@ static inline void yasve_frecps_0x65001800 (CTXARG, int Zd, int Zn, int Zm) {
     perform_FOP_z(zx, esize, Fop_RECPS, false, Zd, Zn, Zm, 99);
 }
 static inline void yasve_frecpx_0x650ca000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frecpx");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RECPX, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frinta_0x6504a000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frinta");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RINTA, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frinti_0x6507a000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frinti");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RINTI, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frintm_0x6502a000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frintm");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RINTM, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frintn_0x6500a000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frintn");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RINTN, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frintp_0x6501a000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frintp");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RINTP, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frintx_0x6506a000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frintx");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RINTX, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frintz_0x6503a000 (CTXARG, int Zd, int Pg, int Zn) {
-    TBD("frintz");
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_FOP_z(zx, esize, Fop_RINTZ, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_frsqrte_0x650f3000 (CTXARG, int Zd, int Zn) {
     NOTTESTED();
@@ -5027,7 +8496,10 @@ static inline void yasve_frsqrts_0x65001c00 (CTXARG, int Zd, int Zn, int Zm) {
     perform_FOP_z(zx, esize, Fop_RSQRTS, false, Zd, Zn, Zn, 99);
 }
 static inline void yasve_fscale_0x65098000 (CTXARG, int Zd, int Pg, int _Zd, int Zm) {
-    TBD("fscale");
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    perform_FSCALE(zx, esize, Zd, Zm, Pg);
 }
 static inline void yasve_fsqrt_0x650da000 (CTXARG, int Zd, int Pg, int Zn) {
     NOTTESTED();
@@ -5062,13 +8534,22 @@ static inline void yasve_fsubr_0x651b8000 (CTXARG, int Zd, int Pg, int _Zd, s64
     perform_FOP_imm(zx, esize, Fop_SUB_REV, true, Zd, immv, Pg);
 }
 static inline void yasve_ftmad_0x65108000 (CTXARG, int Zd, int _Zd, int Zm, s64 imm) {
-    TBD("ftmad");
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    perform_FTMAD(zx, esize, Zd, Zm, (int)imm);
 }
 static inline void yasve_ftsmul_0x65000c00 (CTXARG, int Zd, int Zn, int Zm) {
-    TBD("ftsmul");
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    perform_FTSMUL(zx, esize, Zd, Zn, Zm);
 }
 static inline void yasve_ftssel_0x0420b000 (CTXARG, int Zd, int Zn, int Zm) {
-    TBD("ftssel");
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    perform_FTSSEL(zx, esize, Zd, Zn, Zm);
 }
 
 static inline void yasve_incb_0x0430e000 (CTXARG, int Rdn, int pattern, s64 imm) {
@@ -5185,28 +8666,14 @@ static inline void yasve_index_0x04204800 (CTXARG, int Zd, s64 imm, int Rm) {
 static inline void yasve_insr_0x05243800 (CTXARG, int Zd, int Rm) {
     NOTTESTED();
     int esize = (8 << size);
-    CheckSVEEnabled();
-    size_t vlen = (size_t)(zx->VL / 8);
-    zreg dest = zx->z[Zd];
     u64 src = Xreg_get(zx, Rm, X31ZERO);
-    u8 buf[vlen * 2];
-    memcpy(&buf[esize / 8], &dest, vlen);
-    memcpy(&buf[0], &src, (size_t)(esize / 8));
-    memcpy(&dest, &buf[0], vlen);
-    zx->z[Zd] = dest;
+    perform_INSR_z(zx, esize, Zd, src);
 }
 static inline void yasve_insr_0x05343800 (CTXARG, int Zd, int Vm) {
     NOTTESTED();
     int esize = (8 << size);
-    CheckSVEEnabled();
-    size_t vlen = (size_t)(zx->VL / 8);
-    zreg dest = zx->z[Zd];
     u64 src = Vreg_get(zx, Vm);
-    u8 buf[vlen * 2];
-    memcpy(&buf[esize / 8], &dest, vlen);
-    memcpy(&buf[0], &src, (size_t)(esize / 8));
-    memcpy(&dest, &buf[0], vlen);
-    zx->z[Zd] = dest;
+    perform_INSR_z(zx, esize, Zd, src);
 }
 static inline void yasve_lasta_0x0520a000 (CTXARG, int Rdn, int Pg, int Zn) {
     /* (scalar) */
@@ -5729,14 +9196,70 @@ static inline void yasve_ld1rh_0x84c0c000 (CTXARG, int Zt, int Pg, svemo_t mo, i
     perform_LD1R(zx, esize, msize, unsignedp, Zt, Rn, imm, Pg);
 }
 
-static inline void yasve_ld1rqb_0xa4002000 (TBDARG) {TBD("ld1rqb");}
-static inline void yasve_ld1rqb_0xa4000000 (TBDARG) {TBD("ld1rqb");}
-static inline void yasve_ld1rqd_0xa5802000 (TBDARG) {TBD("ld1rqd");}
-static inline void yasve_ld1rqd_0xa5800000 (TBDARG) {TBD("ld1rqd");}
-static inline void yasve_ld1rqh_0xa4802000 (TBDARG) {TBD("ld1rqh");}
-static inline void yasve_ld1rqh_0xa4800000 (TBDARG) {TBD("ld1rqh");}
-static inline void yasve_ld1rqw_0xa5002000 (TBDARG) {TBD("ld1rqw");}
-static inline void yasve_ld1rqw_0xa5000000 (TBDARG) {TBD("ld1rqw");}
+static inline void yasve_ld1rqb_0xa4002000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, s64 imm, int _0, int _1) {
+    /* (scalar plus immediate) */
+    /* operand: SVE_ADDR_RI_S4x16=(Rn, opr_simm4, 0, 0) */
+    assert(mo == OPR_Rn_IMM);
+    NOTTESTED();
+    int esize = 8;
+    perform_LD1RQ_x_imm(zx, esize, Zt, Rn, imm, Pg);
+}
+static inline void yasve_ld1rqb_0xa4000000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, int Rm, int _0, int _1) {
+    /* (scalar plus scalar) */
+    /* operand: SVE_ADDR_RX=(Rn, Rm, 0, 0) */
+    assert(mo == OPR_Rn_Rm_LSL0);
+    NOTTESTED();
+    int esize = 8;
+    perform_LD1RQ_x_x(zx, esize, Zt, Rn, Rm, Pg);
+}
+static inline void yasve_ld1rqd_0xa5802000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, s64 imm, int _0, int _1) {
+    /* (scalar plus immediate) */
+    /* operand: SVE_ADDR_RI_S4x16=(Rn, opr_simm4, 0, 0) */
+    assert(mo == OPR_Rn_IMM);
+    NOTTESTED();
+    int esize = 64;
+    perform_LD1RQ_x_imm(zx, esize, Zt, Rn, imm, Pg);
+}
+static inline void yasve_ld1rqd_0xa5800000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, int Rm, int _0, int _1) {
+    /* (scalar plus scalar) */
+    /* operand: SVE_ADDR_RX_LSL3=(Rn, Rm, 0, LSL=3) */
+    assert(mo == OPR_Rn_Rm_LSL3);
+    NOTTESTED();
+    int esize = 64;
+    perform_LD1RQ_x_x(zx, esize, Zt, Rn, Rm, Pg);
+}
+static inline void yasve_ld1rqh_0xa4802000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, s64 imm, int _0, int _1) {
+    /* (scalar plus immediate) */
+    /* operand: SVE_ADDR_RI_S4x16=(Rn, opr_simm4, 0, 0) */
+    assert(mo == OPR_Rn_IMM);
+    NOTTESTED();
+    int esize = 16;
+    perform_LD1RQ_x_imm(zx, esize, Zt, Rn, imm, Pg);
+}
+static inline void yasve_ld1rqh_0xa4800000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, int Rm, int _0, int _1) {
+    /* (scalar plus scalar) */
+    /* operand: SVE_ADDR_RX_LSL1=(Rn, Rm, 0, LSL=1) */
+    assert(mo == OPR_Rn_Rm_LSL1);
+    NOTTESTED();
+    int esize = 16;
+    perform_LD1RQ_x_x(zx, esize, Zt, Rn, Rm, Pg);
+}
+static inline void yasve_ld1rqw_0xa5002000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, s64 imm, int _0, int _1) {
+    /* (scalar plus immediate) */
+    /* operand: SVE_ADDR_RI_S4x16=(Rn, opr_simm4, 0, 0) */
+    assert(mo == OPR_Rn_IMM);
+    NOTTESTED();
+    int esize = 32;
+    perform_LD1RQ_x_imm(zx, esize, Zt, Rn, imm, Pg);
+}
+static inline void yasve_ld1rqw_0xa5000000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, int Rm, int _0, int _1) {
+    /* (scalar plus scalar) */
+    /* operand: SVE_ADDR_RX_LSL2=(Rn, Rm, 0, LSL=2) */
+    assert(mo == OPR_Rn_Rm_LSL2);
+    NOTTESTED();
+    int esize = 32;
+    perform_LD1RQ_x_x(zx, esize, Zt, Rn, Rm, Pg);
+}
 
 static inline void yasve_ld1rsb_0x85c08000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, s64 imm, int _0, int _1) {
     /* (64-bit element) */
@@ -7676,7 +11199,7 @@ static inline void yasve_lsr_0x04208400 (CTXARG, int Zd, int Zn, int Zm) {
 static inline void yasve_lsr_0x04209400 (CTXARG, int Zd, int Zn, s64 imm) {
     NOTTESTED();
     int esize = esize_for_shift(imm);
-    u64 shift = (u64)(imm - esize);
+    u64 shift = (u64)((2 * esize) - imm);
     perform_IOP_z_imm(zx, esize, Iop_LSH_R, Zd, Zn, shift);
 }
 static inline void yasve_lsr_0x04118000 (CTXARG, int Zd, int Pg, int _Zd, int Zm) {
@@ -7694,7 +11217,7 @@ static inline void yasve_lsr_0x04198000 (CTXARG, int Zd, int Pg, int _Zd, int Zm
 static inline void yasve_lsr_0x04018000 (CTXARG, int Zd, int Pg, int _Zd, s64 imm) {
     NOTTESTED();
     int esize = esize_for_shift(imm);
-    u64 shift = (u64)(imm - esize);
+    u64 shift = (u64)((2 * esize) - imm);
     perform_IOP_z_imm_pred(zx, esize, Iop_LSH_R, Zd, shift, Pg);
 }
 static inline void yasve_lsrr_0x04158000 (CTXARG, int Zd, int Pg, int _Zd, int Zm) {
@@ -7861,39 +11384,37 @@ static inline void yasve_pfirst_0x2558c000 (CTXARG, int Pdn, int Pg, int Pd) {
     NOTTESTED();
     int esize = 8;
     CheckSVEEnabled();
-    CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    preg result = zx->p[Pdn];
-    int first = -1;
-    for (int e = 0; e < elements; e++) {
-	if (ElemP_get(zx, &mask, e, esize) == 1 && first == -1) {
-	    first = e;
-	}
-    }
+    preg *mask = &zx->p[Pg];
+    preg *result = &zx->p[Pdn];
+    int first = preg_scan_first(zx, mask, mask, esize, 0);
+    int last = preg_scan_last(zx, mask, mask, esize);
     if (first >= 0) {
-	ElemP_set(zx, &result, first, esize, 1);
+	ElemP_set(zx, result, first, esize, 1);
     }
-    NZCV_set(zx, PredTest(zx, &mask, &result, esize));
-    zx->p[Pdn] = result;
+    /* PredTest(mask, result) */
+    bool n = (first >= 0);
+    bool c = !(last >= 0 && ElemP_get(zx, result, last, esize) == 1);
+    bool4 nzcv = {n, !n, c, 0};
+    NZCV_set(zx, nzcv);
 }
 static inline void yasve_pnext_0x2519c400 (CTXARG, int Pdn, int Pg, int Pd) {
     NOTTESTED();
     int esize = (8 << size);
     CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    preg operand = zx->p[Pdn];
+    preg *mask = &zx->p[Pg];
+    preg *operand = &zx->p[Pdn];
+    int from = LastActiveElement(zx, operand, esize) + 1;
+    int next = preg_scan_first(zx, mask, mask, esize, from);
+    int first = preg_scan_first(zx, mask, mask, esize, 0);
+    int last = preg_scan_last(zx, mask, mask, esize);
     preg result = preg_zeros;
-    int next = LastActiveElement(zx, &operand, esize) + 1;
-    while (next < elements && (ElemP_get(zx, &mask, next, esize) == 0)) {
-	next = next + 1;
-    }
-    result = preg_zeros;
-    if (next < elements) {
+    if (next >= 0) {
 	ElemP_set(zx, &result, next, esize, 1);
     }
-    NZCV_set(zx, PredTest(zx, &mask, &result, esize));
+    /* PredTest(mask, result) */
+    bool4 nzcv = {(next >= 0 && next == first), (next == -1),
+		  !(next >= 0 && next == last), 0};
+    NZCV_set(zx, nzcv);
     zx->p[Pdn] = result;
 }
 static inline void yasve_prfb_0x8400c000 (CTXARG, int PRFOP, int Pg, ...) {
@@ -8010,7 +11531,7 @@ static inline void yasve_punpkhi_0x05314000 (CTXARG, int Pd, int Pn) {
 static inline void yasve_punpklo_0x05304000 (CTXARG, int Pd, int Pn) {
     //NOTTESTED00();
     int esize = 16;
-    bool hi = true;
+    bool hi = false;
     perform_UNPACK_p(zx, esize, hi, Pn, Pd);
 }
 static inline void yasve_rbit_0x05278000 (CTXARG, int Zd, int Pg, int Zn) {
@@ -8096,11 +11617,15 @@ static inline void yasve_saddv_0x04002000 (CTXARG, int Vd, int Pg, int Zn) {
 }
 static inline void yasve_scvtf_0x6552a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (16-bit to half-precision) */
-    TBD("scvtf");
+    NOTTESTED();
+    int esize = 16;
+    perform_FOP_z(zx, esize, Fop_CVTF_S16_16, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_scvtf_0x6554a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (32-bit to half-precision) */
-    TBD("scvtf");
+    NOTTESTED();
+    int esize = 32;
+    perform_FOP_z(zx, esize, Fop_CVTF_S32_16, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_scvtf_0x6594a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (32-bit to single-precision) */
@@ -8122,7 +11647,9 @@ static inline void yasve_scvtf_0x65d0a000 (CTXARG, int Zd, int Pg, int Zn) {
 }
 static inline void yasve_scvtf_0x6556a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (64-bit to half-precision) */
-    TBD("scvtf");
+    NOTTESTED();
+    int esize = 64;
+    perform_FOP_z(zx, esize, Fop_CVTF_S64_16, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_scvtf_0x65d4a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (64-bit to single-precision) */
@@ -8265,151 +11792,288 @@ static inline void yasve_smulh_0x04120000 (CTXARG, int Zdn, int Pg, int _Zd, int
     /* (predicated) */
     //NOTTESTED00();
     int esize = (8 << size);
-    bool unsignedp = S64EXT;
-    CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg operand1 = zx->z[Zdn];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 element1 = Elem_get(zx, &operand1, e, esize, unsignedp);
-	u64 element2 = Elem_get(zx, &operand2, e, esize, unsignedp);
-	if (ElemP_get(zx, &mask, e, esize) == 1) {
-	    u64 product = (element1 * element2) >> esize;
-	    Elem_set(zx, &result, e, esize, product);
-	} else {
-	    u64 v = Elem_get(zx, &operand1, e, esize, DONTCARE);
-	    Elem_set(zx, &result, e, esize, v);
-	}
-    }
-    zx->z[Zdn] = result;
+    perform_MULH(zx, esize, false, Zdn, Zm, Pg);
 }
 static inline void yasve_splice_0x052c8000 (CTXARG, int Zdn, int Pg, int Zd, int Zm) {
     NOTTESTED();
     int esize = (8 << size);
-    CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    preg mask = zx->p[Pg];
-    zreg operand1 = zx->z[Zdn];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    int x = 0;
-    bool active = false;
-    int lastnum = LastActiveElement(zx, &mask, esize);
-    if (lastnum >= 0) {
-	for (int e = 0; e < lastnum; e++) {
-	    active = (active || ElemP_get(zx, &mask, e, esize) == 1);
-	    if (active) {
-		u64 v = Elem_get(zx, &operand1, e, esize, DONTCARE);
-		Elem_set(zx, &result, x, esize, v);
-		x = x + 1;
-	    }
-	}
-    }
-    elements = (elements - x - 1);
-    for (int e = 0; e < elements; e++) {
-	u64 v = Elem_get(zx, &operand2, e, esize, DONTCARE);
-	Elem_set(zx, &result, x, esize, v);
-	x = x + 1;
-    }
-    zx->z[Zdn] = result;
+    perform_SPLICE_z(zx, esize, Zdn, Pg, Zm);
 }
-static inline void yasve_sqadd_0x04201000 (TBDARG) {
-    TBD("sqadd");
+static inline void yasve_sqadd_0x04201000 (CTXARG, int Zd, int Zn, int Zm) {
+    /* (vectors) */
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_QADD_z(zx, esize, false, false, Zd, Zn, Zm);
 }
-static inline void yasve_sqadd_0x2524c000 (TBDARG) {
-    TBD("sqadd");
+static inline void yasve_sqadd_0x2524c000 (CTXARG, int Zdn, int _Zd, s64 imm0) {
+    /* (immediate) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int sh = opr_sh13(opc);
+    if (((size << 1) | sh) == 1) {ReservedValue();}
+    u64 imm = (u64)imm0;
+    if (sh == 1) {
+	imm = imm << 8;
+    }
+    perform_QADD_imm(zx, esize, false, false, Zdn, imm);
 }
-static inline void yasve_sqdecb_0x0430f800 (TBDARG) {
-    TBD("sqdecb");
+static inline void yasve_sqdecb_0x0430f800 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqdecb_0x0420f800 (TBDARG) {
-    TBD("sqdecb");
+static inline void yasve_sqdecb_0x0420f800 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqdecd_0x04e0c800 (TBDARG) {
-    TBD("sqdecd");
+static inline void yasve_sqdecd_0x04e0c800 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, (- immv));
 }
-static inline void yasve_sqdecd_0x04f0f800 (TBDARG) {
-    TBD("sqdecd");
+static inline void yasve_sqdecd_0x04f0f800 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 64;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqdecd_0x04e0f800 (TBDARG) {
-    TBD("sqdecd");
+static inline void yasve_sqdecd_0x04e0f800 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 64;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqdech_0x0460c800 (TBDARG) {
-    TBD("sqdech");
+static inline void yasve_sqdech_0x0460c800 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 16;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, (- immv));
 }
-static inline void yasve_sqdech_0x0470f800 (TBDARG) {
-    TBD("sqdech");
+static inline void yasve_sqdech_0x0470f800 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqdech_0x0460f800 (TBDARG) {
-    TBD("sqdech");
+static inline void yasve_sqdech_0x0460f800 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqdecp_0x252a8000 (TBDARG) {
-    TBD("sqdecp");
+static inline void yasve_sqdecp_0x252a8000 (CTXARG, int Zdn, int Pg) {
+    /* (vector) */
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    bool unsignedp = false;
+    perform_QINC_z_pred(zx, esize, unsignedp, Zdn, Pg, -1);
 }
-static inline void yasve_sqdecp_0x252a8c00 (TBDARG) {
-    TBD("sqdecp");
+static inline void yasve_sqdecp_0x252a8c00 (CTXARG, int Rdn, int Pg) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 64;
+    bool unsignedp = false;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, -1);
 }
-static inline void yasve_sqdecp_0x252a8800 (TBDARG) {
-    TBD("sqdecp");
+static inline void yasve_sqdecp_0x252a8800 (CTXARG, int Rdn, int Pg, int _Rdn) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 32;
+    bool unsignedp = false;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, -1);
 }
-static inline void yasve_sqdecw_0x04a0c800 (TBDARG) {
-    TBD("sqdecw");
+static inline void yasve_sqdecw_0x04a0c800 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, (- immv));
 }
-static inline void yasve_sqdecw_0x04b0f800 (TBDARG) {
-    TBD("sqdecw");
+static inline void yasve_sqdecw_0x04b0f800 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqdecw_0x04a0f800 (TBDARG) {
-    TBD("sqdecw");
+static inline void yasve_sqdecw_0x04a0f800 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_sqincb_0x0430f000 (TBDARG) {
-    TBD("sqincb");
+static inline void yasve_sqincb_0x0430f000 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqincb_0x0420f000 (TBDARG) {
-    TBD("sqincb");
+static inline void yasve_sqincb_0x0420f000 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqincd_0x04e0c000 (TBDARG) {
-    TBD("sqincd");
+static inline void yasve_sqincd_0x04e0c000 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, immv);
 }
-static inline void yasve_sqincd_0x04f0f000 (TBDARG) {
-    TBD("sqincd");
+static inline void yasve_sqincd_0x04f0f000 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 64;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqincd_0x04e0f000 (TBDARG) {
-    TBD("sqincd");
+static inline void yasve_sqincd_0x04e0f000 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 64;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqinch_0x0460c000 (TBDARG) {
-    TBD("sqinch");
+static inline void yasve_sqinch_0x0460c000 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 16;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, immv);
 }
-static inline void yasve_sqinch_0x0470f000 (TBDARG) {
-    TBD("sqinch");
+static inline void yasve_sqinch_0x0470f000 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqinch_0x0460f000 (TBDARG) {
-    TBD("sqinch");
+static inline void yasve_sqinch_0x0460f000 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqincp_0x25288000 (TBDARG) {
-    TBD("sqincp");
+static inline void yasve_sqincp_0x25288000 (CTXARG, int Zdn, int Pg) {
+    /* (vector) */
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    bool unsignedp = false;
+    perform_QINC_z_pred(zx, esize, unsignedp, Zdn, Pg, 1);
 }
-static inline void yasve_sqincp_0x25288c00 (TBDARG) {
-    TBD("sqincp");
+static inline void yasve_sqincp_0x25288c00 (CTXARG, int Rdn, int Pg) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 64;
+    bool unsignedp = false;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, 1);
 }
-static inline void yasve_sqincp_0x25288800 (TBDARG) {
-    TBD("sqincp");
+static inline void yasve_sqincp_0x25288800 (CTXARG, int Rdn, int Pg, int _Rdn) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 32;
+    bool unsignedp = false;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, 1);
 }
-static inline void yasve_sqincw_0x04a0c000 (TBDARG) {
-    TBD("sqincw");
+static inline void yasve_sqincw_0x04a0c000 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, immv);
 }
-static inline void yasve_sqincw_0x04b0f000 (TBDARG) {
-    TBD("sqincw");
+static inline void yasve_sqincw_0x04b0f000 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 64;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqincw_0x04a0f000 (TBDARG) {
-    TBD("sqincw");
+static inline void yasve_sqincw_0x04a0f000 (CTXARG, int Rdn, int _Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 32;
+    bool unsignedp = false;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_sqsub_0x04201800 (TBDARG) {
-    TBD("sqsub");
+static inline void yasve_sqsub_0x04201800 (CTXARG, int Zd, int Zn, int Zm) {
+    /* (vectors) */
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_QADD_z(zx, esize, true, false, Zd, Zn, Zm);
 }
-static inline void yasve_sqsub_0x2526c000 (TBDARG) {
-    TBD("sqsub");
+static inline void yasve_sqsub_0x2526c000 (CTXARG, int Zdn, int _Zd, s64 imm0) {
+    /* (immediate) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int sh = opr_sh13(opc);
+    if (((size << 1) | sh) == 1) {ReservedValue();}
+    u64 imm = (u64)imm0;
+    if (sh == 1) {
+	imm = imm << 8;
+    }
+    perform_QADD_imm(zx, esize, true, false, Zdn, imm);
 }
 
 static inline void yasve_st1b_0xe4004000 (CTXARG, int Zt, int Pg, svemo_t mo, int Rn, int Rm, int _0, int _1) {
@@ -9344,87 +13008,31 @@ static inline void yasve_sxtw_0x04d4a000 (CTXARG, int Zd, int Pg, int Zn) {
 static inline void yasve_tbl_0x05203000 (CTXARG, int Zd, int Zn, int Zm) {
     NOTTESTED();
     int esize = (8 << size);
-    CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    for (int e = 0; e < elements; e++) {
-	u64 idx = (u64)Elem_get(zx, &operand2, e, esize, U64EXT);
-	u64 v = ((idx < (u64)elements)
-		 ? Elem_get(zx, &operand1, (int)idx, esize, DONTCARE)
-		 : 0);
-	Elem_set(zx, &result, e, esize, v);
-    }
-    zx->z[Zd] = result;
+    perform_TBL_z(zx, esize, Zd, Zn, Zm);
 }
 static inline void yasve_trn1_0x05205000 (CTXARG, int Pd, int Pn, int Pm) {
     NOTTESTED();
     int esize = (8 << size);
     int part = 0;
-    CheckSVEEnabled();
-    int pairs = zx->VL / (esize * 2);
-    preg operand1 = zx->p[Pn];
-    preg operand2 = zx->p[Pm];
-    preg result = preg_zeros;
-    for (int p = 0; p < pairs; p++) {
-	bool v0 = ElemP_get(zx, &operand1, (2*p+part), esize);
-	bool v1 = ElemP_get(zx, &operand2, (2*p+part), esize);
-	ElemP_set(zx, &result, 2*p+0, esize, v0);
-	ElemP_set(zx, &result, 2*p+1, esize, v1);
-    }
-    zx->p[Pd] = result;
+    perform_TRN_p(zx, esize, part, Pn, Pm, Pd);
 }
 static inline void yasve_trn1_0x05207000 (CTXARG, int Zd, int Zn, int Zm) {
     NOTTESTED();
     int esize = (8 << size);
     int part = 0;
-    CheckSVEEnabled();
-    int pairs = zx->VL / (esize * 2);
-    zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    for (int p = 0; p < pairs; p++) {
-	u64 v0 = Elem_get(zx, &operand1, (2*p+part), esize, DONTCARE);
-	u64 v1 = Elem_get(zx, &operand2, (2*p+part), esize, DONTCARE);
-	Elem_set(zx, &result, (2*p+0), esize, v0);
-	Elem_set(zx, &result, (2*p+1), esize, v1);
-    }
-    zx->z[Zd] = result;
+    perform_TRN_z(zx, esize, part, Zn, Zm, Zd);
 }
 static inline void yasve_trn2_0x05205400 (CTXARG, int Pd, int Pn, int Pm) {
     NOTTESTED();
     int esize = (8 << size);
     int part = 1;
-    CheckSVEEnabled();
-    int pairs = zx->VL / (esize * 2);
-    preg operand1 = zx->p[Pn];
-    preg operand2 = zx->p[Pm];
-    preg result = preg_zeros;
-    for (int p = 0; p < pairs; p++) {
-	bool v0 = ElemP_get(zx, &operand1, (2*p+part), esize);
-	bool v1 = ElemP_get(zx, &operand2, (2*p+part), esize);
-	ElemP_set(zx, &result, 2*p+0, esize, v0);
-	ElemP_set(zx, &result, 2*p+1, esize, v1);
-    }
-    zx->p[Pd] = result;
+    perform_TRN_p(zx, esize, part, Pn, Pm, Pd);
 }
 static inline void yasve_trn2_0x05207400 (CTXARG, int Zd, int Zn, int Zm) {
     NOTTESTED();
     int esize = (8 << size);
     int part = 1;
-    CheckSVEEnabled();
-    int pairs = zx->VL / (esize * 2);
-    zreg operand1 = zx->z[Zn];
-    zreg operand2 = zx->z[Zm];
-    zreg result = zreg_zeros;
-    for (int p = 0; p < pairs; p++) {
-	u64 v0 = Elem_get(zx, &operand1, (2*p+part), esize, DONTCARE);
-	u64 v1 = Elem_get(zx, &operand2, (2*p+part), esize, DONTCARE);
-	Elem_set(zx, &result, (2*p+0), esize, v0);
-	Elem_set(zx, &result, (2*p+1), esize, v1);
-    }
-    zx->z[Zd] = result;
+    perform_TRN_z(zx, esize, part, Zn, Zm, Zd);
 }
 static inline void yasve_uabd_0x040d0000 (CTXARG, int Zd, int Pg, int _Zd, int Zm) {
     NOTTESTED();
@@ -9437,15 +13045,17 @@ static inline void yasve_uaddv_0x04012000 (CTXARG, int Vd, int Pg, int Zn) {
     u64 unitv = 0ULL;
     perform_IREDUCE_seq(zx, esize, Iop_ADD, U64EXT, unitv, Vd, Zn, Pg);
 }
-static inline void yasve_ucvtf_0x6553a000 (TBDARG) {
+static inline void yasve_ucvtf_0x6553a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (16-bit to half-precision) */
-    /* (SVE_Zd, SVE_Pg3, SVE_Zn) */
-    TBD("ucvtf");
+    NOTTESTED();
+    int esize = 16;
+    perform_FOP_z(zx, esize, Fop_CVTF_U16_16, true, Zd, 99, Zn, Pg);
 }
-static inline void yasve_ucvtf_0x6555a000 (TBDARG) {
+static inline void yasve_ucvtf_0x6555a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (32-bit to half-precision) */
-    /* (SVE_Zd, SVE_Pg3, SVE_Zn) */
-    TBD("ucvtf");
+    NOTTESTED();
+    int esize = 32;
+    perform_FOP_z(zx, esize, Fop_CVTF_U32_16, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_ucvtf_0x6595a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (32-bit to single-precision) */
@@ -9465,10 +13075,11 @@ static inline void yasve_ucvtf_0x65d1a000 (CTXARG, int Zd, int Pg, int Zn) {
     /*bool unsignedp = true;*/
     perform_FOP_z(zx, esize, Fop_CVTF_U32_64, true, Zd, 99, Zn, Pg);
 }
-static inline void yasve_ucvtf_0x6557a000 (TBDARG) {
+static inline void yasve_ucvtf_0x6557a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (64-bit to half-precision) */
-    /* (SVE_Zd, SVE_Pg3, SVE_Zn) */
-    TBD("ucvtf");
+    NOTTESTED();
+    int esize = 64;
+    perform_FOP_z(zx, esize, Fop_CVTF_U64_16, true, Zd, 99, Zn, Pg);
 }
 static inline void yasve_ucvtf_0x65d5a000 (CTXARG, int Zd, int Pg, int Zn) {
     /* (64-bit to single-precision) */
@@ -9561,146 +13172,287 @@ static inline void yasve_uminv_0x040b2000 (CTXARG, int Vd, int Pg, int Zn) {
     u64 unitv = (~0ULL);
     perform_IREDUCE_seq(zx, esize, Iop_UMIN, U64EXT, unitv, Vd, Zn, Pg);
 }
-static inline void yasve_umulh_0x04130000 (TBDARG) {
-    TBD("umulh");
+static inline void yasve_umulh_0x04130000 (CTXARG, int Zdn, int Pg, int _Zd, int Zm) {
+    /* (predicated) */
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_MULH(zx, esize, true, Zdn, Zm, Pg);
 }
-static inline void yasve_uqadd_0x04201400 (TBDARG) {
-    TBD("uqadd");
+static inline void yasve_uqadd_0x04201400 (CTXARG, int Zd, int Zn, int Zm) {
+    /* (vectors) */
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_QADD_z(zx, esize, false, true, Zd, Zn, Zm);
 }
-static inline void yasve_uqadd_0x2525c000 (TBDARG) {
-    TBD("uqadd");
+static inline void yasve_uqadd_0x2525c000 (CTXARG, int Zdn, int _Zd, s64 imm0) {
+    /* (immediate) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int sh = opr_sh13(opc);
+    if (((size << 1) | sh) == 1) {ReservedValue();}
+    u64 imm = (u64)imm0;
+    if (sh == 1) {
+	imm = imm << 8;
+    }
+    perform_QADD_imm(zx, esize, false, true, Zdn, imm);
 }
-static inline void yasve_uqdecb_0x0420fc00 (TBDARG) {
-    TBD("uqdecb");
+static inline void yasve_uqdecb_0x0420fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_uqdecb_0x0430fc00 (TBDARG) {
-    TBD("uqdecb");
+static inline void yasve_uqdecb_0x0430fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
 static inline void yasve_uqdecd_0x04e0cc00 (CTXARG, int Zdn, int pattern, s64 imm) {
     /* (vector) */
-    /* (Zd, SVE_PATTERN_SCALED) */
     NOTTESTED();
     int esize = 64;
-    int pat = pattern;
-    bool unsignedp = U64EXT;
-    CheckSVEEnabled();
-    int elements = zx->VL / esize;
-    int count = DecodePredCount(zx, pat, esize);
-    zreg operand1 = zx->z[Zdn];
-    zreg result;
-    for (int e = 0; e < elements; e++) {
-	s64 element1 = (s64)Elem_get(zx, &operand1, e, esize, unsignedp);
-	saturated_t sv = SatQ2(element1, (s64)-(count * imm), esize, unsignedp);
-	Elem_set(zx, &result, e, esize, sv.v);
-    }
-    zx->z[Zdn] = result;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, (- immv));
 }
-static inline void yasve_uqdecd_0x04e0fc00 (CTXARG, int Rdn, int pattern, s64 imm0) {
+static inline void yasve_uqdecd_0x04e0fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
     /* (scalar/32-bit) */
-    /* (Rd, SVE_PATTERN_SCALED) */
     NOTTESTED();
     int esize = 64;
-    int pat = pattern;
-    s64 imm = imm0 + 1;
-    bool unsignedp = true;
     int ssize = 32;
-    CheckSVEEnabled();
-    int count = DecodePredCount(zx, pat, esize);
-    u64 operand1 = Xreg_get(zx, Rdn, X31ZERO);
-    s64 element1 = (s64)operand1;
-    saturated_t result = SatQ2(element1, (s64)-(count * imm), ssize, unsignedp);
-    Xreg_set(zx, Rdn, (u64)result.v);
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_uqdecd_0x04f0fc00 (CTXARG, int Rdn, int pattern, s64 imm0) {
+static inline void yasve_uqdecd_0x04f0fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
     /* (scalar/64-bit) */
-    /* (Rd, SVE_PATTERN_SCALED) */
-    //NOTTESTED00();
+    NOTTESTED();
     int esize = 64;
-    int pat = pattern;
-    s64 imm = imm0 + 1;
-    bool unsignedp = true;
     int ssize = 64;
-    CheckSVEEnabled();
-    int count = DecodePredCount(zx, pat, esize);
-    u64 operand1 = Xreg_get(zx, Rdn, X31ZERO);
-    s64 element1 = (s64)operand1;
-    saturated_t result = SatQ2(element1, (s64)-(count * imm), ssize, unsignedp);
-    Xreg_set(zx, Rdn, (u64)result.v);
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_uqdech_0x0460cc00 (TBDARG) {
-    TBD("uqdech");
+static inline void yasve_uqdech_0x0460cc00 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 16;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, (- immv));
 }
-static inline void yasve_uqdech_0x0460fc00 (TBDARG) {
-    TBD("uqdech");
+static inline void yasve_uqdech_0x0460fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_uqdech_0x0470fc00 (TBDARG) {
-    TBD("uqdech");
+static inline void yasve_uqdech_0x0470fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_uqdecp_0x252b8000 (TBDARG) {
-    TBD("uqdecp");
+static inline void yasve_uqdecp_0x252b8000 (CTXARG, int Zdn, int Pg) {
+    /* (vector) */
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    bool unsignedp = true;
+    perform_QINC_z_pred(zx, esize, unsignedp, Zdn, Pg, -1);
 }
-static inline void yasve_uqdecp_0x252b8800 (TBDARG) {
-    TBD("uqdecp");
+static inline void yasve_uqdecp_0x252b8800 (CTXARG, int Rdn, int Pg) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 32;
+    bool unsignedp = true;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, -1);
 }
-static inline void yasve_uqdecp_0x252b8c00 (TBDARG) {
-    TBD("uqdecp");
+static inline void yasve_uqdecp_0x252b8c00 (CTXARG, int Rdn, int Pg) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 64;
+    bool unsignedp = true;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, -1);
 }
-static inline void yasve_uqdecw_0x04a0cc00 (TBDARG) {
-    TBD("uqdecw");
+static inline void yasve_uqdecw_0x04a0cc00 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, (- immv));
 }
-static inline void yasve_uqdecw_0x04a0fc00 (TBDARG) {
-    TBD("uqdecw");
+static inline void yasve_uqdecw_0x04a0fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_uqdecw_0x04b0fc00 (TBDARG) {
-    TBD("uqdecw");
+static inline void yasve_uqdecw_0x04b0fc00 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, (- immv));
 }
-static inline void yasve_uqincb_0x0420f400 (TBDARG) {
-    TBD("uqincb");
+static inline void yasve_uqincb_0x0420f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqincb_0x0430f400 (TBDARG) {
-    TBD("uqincb");
+static inline void yasve_uqincb_0x0430f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 8;
+    int ssize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqincd_0x04e0c400 (TBDARG) {
-    TBD("uqincd");
+static inline void yasve_uqincd_0x04e0c400 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, immv);
 }
-static inline void yasve_uqincd_0x04e0f400 (TBDARG) {
-    TBD("uqincd");
+static inline void yasve_uqincd_0x04e0f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 64;
+    int ssize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqincd_0x04f0f400 (TBDARG) {
-    TBD("uqincd");
+static inline void yasve_uqincd_0x04f0f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 64;
+    int ssize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqinch_0x0460c400 (TBDARG) {
-    TBD("uqinch");
+static inline void yasve_uqinch_0x0460c400 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 16;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, immv);
 }
-static inline void yasve_uqinch_0x0460f400 (TBDARG) {
-    TBD("uqinch");
+static inline void yasve_uqinch_0x0460f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqinch_0x0470f400 (TBDARG) {
-    TBD("uqinch");
+static inline void yasve_uqinch_0x0470f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 16;
+    int ssize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqincp_0x25298000 (TBDARG) {
-    TBD("uqincp");
+static inline void yasve_uqincp_0x25298000 (CTXARG, int Zdn, int Pg) {
+    /* (vector) */
+    NOTTESTED();
+    if (size == 0) {UnallocatedEncoding();}
+    int esize = (8 << size);
+    bool unsignedp = true;
+    perform_QINC_z_pred(zx, esize, unsignedp, Zdn, Pg, 1);
 }
-static inline void yasve_uqincp_0x25298800 (TBDARG) {
-    TBD("uqincp");
+static inline void yasve_uqincp_0x25298800 (CTXARG, int Rdn, int Pg) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 32;
+    bool unsignedp = true;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, 1);
 }
-static inline void yasve_uqincp_0x25298c00 (TBDARG) {
-    TBD("uqincp");
+static inline void yasve_uqincp_0x25298c00 (CTXARG, int Rdn, int Pg) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int ssize = 64;
+    bool unsignedp = true;
+    perform_QINC_x_pred(zx, esize, ssize, unsignedp, Rdn, Pg, 1);
 }
-static inline void yasve_uqincw_0x04a0c400 (TBDARG) {
-    TBD("uqincw");
+static inline void yasve_uqincw_0x04a0c400 (CTXARG, int Zdn, int pattern, s64 imm) {
+    /* (vector) */
+    NOTTESTED();
+    int esize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_z(zx, esize, unsignedp, Zdn, pattern, immv);
 }
-static inline void yasve_uqincw_0x04a0f400 (TBDARG) {
-    TBD("uqincw");
+static inline void yasve_uqincw_0x04a0f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/32-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 32;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqincw_0x04b0f400 (TBDARG) {
-    TBD("uqincw");
+static inline void yasve_uqincw_0x04b0f400 (CTXARG, int Rdn, int pattern, s64 imm) {
+    /* (scalar/64-bit) */
+    NOTTESTED();
+    int esize = 32;
+    int ssize = 64;
+    bool unsignedp = true;
+    s64 immv = imm + 1;
+    perform_QINC_x(zx, esize, ssize, unsignedp, Rdn, pattern, immv);
 }
-static inline void yasve_uqsub_0x04201c00 (TBDARG) {
-    TBD("uqsub");
+static inline void yasve_uqsub_0x04201c00 (CTXARG, int Zd, int Zn, int Zm) {
+    /* (vectors) */
+    NOTTESTED();
+    int esize = (8 << size);
+    perform_QADD_z(zx, esize, true, true, Zd, Zn, Zm);
 }
-static inline void yasve_uqsub_0x2527c000 (TBDARG) {
-    TBD("uqsub");
+static inline void yasve_uqsub_0x2527c000 (CTXARG, int Zdn, int _Zd, s64 imm0) {
+    /* (immediate) */
+    NOTTESTED();
+    int esize = (8 << size);
+    int sh = opr_sh13(opc);
+    if (((size << 1) | sh) == 1) {ReservedValue();}
+    u64 imm = (u64)imm0;
+    if (sh == 1) {
+	imm = imm << 8;
+    }
+    perform_QADD_imm(zx, esize, true, true, Zdn, imm);
 }
 static inline void yasve_uunpkhi_0x05333800 (CTXARG, int Zd, int Zn) {
     //NOTTESTED00();
@@ -24,6 +24,7 @@ const char yasve_id[] = "$Id: yasve-v2.1 (2022-02-17) $";
 #include <sys/types.h>
 #include <ucontext.h>
 #include <sys/syscall.h>
+#include <sys/auxv.h>
 #include <arm_neon.h>
 
 #include "yasve.h"
@@ -151,6 +152,28 @@ extern void yasve_perform(svecxt_t *zx, u32 opc);
 
 /* ================================================================ */
 
+/* Capabilities of the host.  Kernels are selected at loading by the
+   host capabilities.  Setting the environment variable YASVE_KERNEL
+   to "scalar" selects the scalar reference kernels instead. */
+
+#ifndef HWCAP_FPHP
+#define HWCAP_FPHP (1 << 9)
+#endif
+#ifndef HWCAP_ASIMDHP
+#define HWCAP_ASIMDHP (1 << 10)
+#endif
+#ifndef HWCAP_ASIMDDP
+#define HWCAP_ASIMDDP (1 << 20)
+#endif
+
+typedef enum {KERNEL_SCALAR, KERNEL_NEON, KERNEL_DOTPROD,
+	      KERNEL_FP16} kernel_t;
+
+static unsigned long host_hwcap = 0;
+static kernel_t dotp_kernel = KERNEL_NEON;
+static kernel_t fp16_kernel = KERNEL_NEON;
+static kernel_t cvt_kernel = KERNEL_NEON;
+
 /* Installs a SIGILL handler. */
 
 static void __attribute__ ((constructor))
@@ -158,6 +181,31 @@ yasve_init()
 {
     assert(sizeof(1ULL) == 8 && sizeof(0ULL) == 8);
 
+    if (1) {
+	host_hwcap = getauxval(AT_HWCAP);
+	bool scalarp = false;
+	char *e = getenv("YASVE_KERNEL");
+	if (e != 0 && strcmp(e, "scalar") == 0) {
+	    scalarp = true;
+	}
+	if (scalarp) {
+	    dotp_kernel = KERNEL_SCALAR;
+	} else if ((host_hwcap & HWCAP_ASIMDDP) != 0) {
+	    dotp_kernel = KERNEL_DOTPROD;
+	} else {
+	    dotp_kernel = KERNEL_NEON;
+	}
+	unsigned long fp16 = (HWCAP_FPHP | HWCAP_ASIMDHP);
+	if (scalarp) {
+	    fp16_kernel = KERNEL_SCALAR;
+	} else if ((host_hwcap & fp16) == fp16) {
+	    fp16_kernel = KERNEL_FP16;
+	} else {
+	    fp16_kernel = KERNEL_NEON;
+	}
+	cvt_kernel = (scalarp ? KERNEL_SCALAR : KERNEL_NEON);
+    }
+
     if (1) {
 	struct sigaction sa;
 	memset(&sa, 0, sizeof(sa));